@@ -37,6 +37,13 @@
 
 #if defined(_WIN32) || defined(__MINGW32__)
 # include <direct.h>  // mkdir
+#else
+# include <fcntl.h>  // open
+# include <sys/mman.h>  // mmap
+# include <unistd.h>  // close
+#endif
+#ifdef VL_THREADED
+# include <thread>
 #endif
 
 #define VL_VALUE_STRING_MAX_WIDTH 8192  ///< Max static char array for VL_VALUE_STRING
@@ -267,38 +274,47 @@ static vluint32_t vl_sys_rand32() VL_MT_UNSAFE {
 #endif
 }
 
-vluint64_t vl_rand64() VL_MT_SAFE {
+static void vl_rand_seed(vluint64_t* statep, int seed) VL_MT_SAFE {
     static VerilatedMutex s_mutex;
+    VerilatedLockGuard lock(s_mutex);  // vl_sys_rand32 is not threadsafe
+    if (seed != 0) {
+        statep[0] = ((static_cast<vluint64_t>(seed) << 32)
+                     ^ (static_cast<vluint64_t>(seed)));
+        statep[1] = ((static_cast<vluint64_t>(seed) << 32)
+                     ^ (static_cast<vluint64_t>(seed)));
+    } else {
+        statep[0] = ((static_cast<vluint64_t>(vl_sys_rand32()) << 32)
+                     ^ (static_cast<vluint64_t>(vl_sys_rand32())));
+        statep[1] = ((static_cast<vluint64_t>(vl_sys_rand32()) << 32)
+                     ^ (static_cast<vluint64_t>(vl_sys_rand32())));
+    }
+    // Fix state as algorithm is slow to randomize if many zeros
+    // This causes a loss of ~ 1 bit of seed entropy, no big deal
+    if (VL_COUNTONES_I(statep[0]) < 10) statep[0] = ~statep[0];
+    if (VL_COUNTONES_I(statep[1]) < 10) statep[1] = ~statep[1];
+}
+
+static inline vluint64_t vl_rand_next(vluint64_t* statep) VL_MT_UNSAFE {
+    // Xoroshiro128+ algorithm
+    vluint64_t result = statep[0] + statep[1];
+    statep[1] ^= statep[0];
+    statep[0] = (((statep[0] << 55) | (statep[0] >> 9))
+                 ^ statep[1] ^ (statep[1] << 14));
+    statep[1] = (statep[1] << 36) | (statep[1] >> 28);
+    return result;
+}
+
+vluint64_t vl_rand64() VL_MT_SAFE {
+    // Each context has its own generator, so models with different seeds
+    // get independent sequences, even when evaluated on one thread
+    if (VerilatedContext* contextp = Verilated::threadContextp()) return contextp->rand64();
     static VL_THREAD_LOCAL bool t_seeded = false;
     static VL_THREAD_LOCAL vluint64_t t_state[2];
     if (VL_UNLIKELY(!t_seeded)) {
         t_seeded = true;
-        {
-            VerilatedLockGuard lock(s_mutex);
-            if (Verilated::randSeed() != 0) {
-                t_state[0] = ((static_cast<vluint64_t>(Verilated::randSeed()) << 32)
-                              ^ (static_cast<vluint64_t>(Verilated::randSeed())));
-                t_state[1] = ((static_cast<vluint64_t>(Verilated::randSeed()) << 32)
-                              ^ (static_cast<vluint64_t>(Verilated::randSeed())));
-            } else {
-                t_state[0] = ((static_cast<vluint64_t>(vl_sys_rand32()) << 32)
-                              ^ (static_cast<vluint64_t>(vl_sys_rand32())));
-                t_state[1] = ((static_cast<vluint64_t>(vl_sys_rand32()) << 32)
-                              ^ (static_cast<vluint64_t>(vl_sys_rand32())));
-            }
-            // Fix state as algorithm is slow to randomize if many zeros
-            // This causes a loss of ~ 1 bit of seed entropy, no big deal
-            if (VL_COUNTONES_I(t_state[0]) < 10) t_state[0] = ~t_state[0];
-            if (VL_COUNTONES_I(t_state[1]) < 10) t_state[1] = ~t_state[1];
-        }
+        vl_rand_seed(t_state, Verilated::randSeed());
     }
-    // Xoroshiro128+ algorithm
-    vluint64_t result = t_state[0] + t_state[1];
-    t_state[1] ^= t_state[0];
-    t_state[0] = (((t_state[0] << 55) | (t_state[0] >> 9))
-                  ^ t_state[1] ^ (t_state[1] << 14));
-    t_state[1] = (t_state[1] << 36) | (t_state[1] >> 28);
-    return result;
+    return vl_rand_next(t_state);
 }
 
 IData VL_RANDOM_I(int obits) VL_MT_SAFE {
@@ -605,246 +621,272 @@ std::string VL_DECIMAL_NW(int width, WDataInP lwp) VL_MT_SAFE {
 // Do a va_arg returning a quad, assuming input argument is anything less than wide
 #define _VL_VA_ARG_Q(ap, bits) (((bits) <= VL_IDATASIZE) ? va_arg(ap, IData) : va_arg(ap, QData))
 
-void _vl_vsformat(std::string& output, const char* formatp, va_list ap) VL_MT_SAFE {
+static void _vl_vsformat_ops(std::string& output, const char* formatp,
+                             const VerilatedFormatOp* opsp, va_list ap) VL_MT_SAFE {
     // Format a Verilog $write style format into the output list
     // The format must be pre-processed (and lower cased) by Verilator
     // Arguments are in "width, arg-value (or WDataIn* if wide)" form
+    // Either formatp is a printf-like format string, or opsp is the same
+    // format already split into conversions by Verilator.
     //
     // Note uses a single buffer internally; presumes only one usage per printf
     // Note also assumes variables < 64 are not wide, this assumption is
     // sometimes not true in low-level routines written here in verilated.cpp
     static VL_THREAD_LOCAL char tmp[VL_VALUE_STRING_MAX_WIDTH];
     static VL_THREAD_LOCAL char tmpf[VL_VALUE_STRING_MAX_WIDTH];
-    const char* pctp = NULL;  // Most recent %##.##g format
-    bool inPct = false;
-    bool widthSet = false;
-    int width = 0;
-    for (const char* pos = formatp; *pos; ++pos) {
-        if (!inPct && pos[0]=='%') {
-            pctp = pos;
-            inPct = true;
-            widthSet = false;
-            width = 0;
-        } else if (!inPct) {  // Normal text
-            // Fast-forward to next escape and add to output
-            const char* ep = pos;
-            while (ep[0] && ep[0]!='%') ep++;
-            if (ep != pos) {
-                output.append(pos, ep-pos);
-                pos += ep-pos-1;
+    const char* pos = formatp;
+    while (true) {
+        // Find next conversion
+        char fmt = '\0';
+        const char* pctp = NULL;  // Most recent %##.##g format
+        int speclen = 0;  // Length of format at pctp
+        bool widthSet = false;
+        bool zeroPad = false;
+        int width = 0;
+        if (opsp) {
+            output.append(opsp->m_textp, opsp->m_textlen);
+            fmt = opsp->m_fmt;
+            pctp = opsp->m_specp;
+            speclen = pctp ? strlen(pctp) : 0;
+            widthSet = opsp->m_widthSet;
+            zeroPad = opsp->m_zeroPad;
+            width = opsp->m_width;
+            ++opsp;
+        } else {
+            bool inPct = false;
+            for (; *pos; ++pos) {
+                if (!inPct && pos[0]=='%') {
+                    pctp = pos;
+                    inPct = true;
+                    widthSet = false;
+                    width = 0;
+                } else if (!inPct) {  // Normal text
+                    // Fast-forward to next escape and add to output
+                    const char* ep = pos;
+                    while (ep[0] && ep[0]!='%') ep++;
+                    if (ep != pos) {
+                        output.append(pos, ep-pos);
+                        pos += ep-pos-1;
+                    }
+                } else if ((pos[0] >= '0' && pos[0] <= '9') || pos[0] == '.') {
+                    // Get more digits
+                    if (pos[0] != '.') {
+                        widthSet = true;
+                        width = width*10 + (pos[0] - '0');
+                    }
+                } else if (pos[0] == '%') {
+                    inPct = false;
+                    output += '%';
+                } else {  // Format character
+                    fmt = pos[0];
+                    zeroPad = pctp[1] == '0';
+                    speclen = pos - pctp + 1;
+                    ++pos;
+                    break;
+                }
             }
-        } else {  // Format character
-            inPct = false;
-            char fmt = pos[0];
+        }
+        if (!fmt) break;  // End of format
+        switch (fmt) {
+        case 'N': {  // "C" string with name of module, add . if needed
+            const char* cstrp = va_arg(ap, const char*);
+            if (VL_LIKELY(*cstrp)) { output += cstrp; output += '.'; }
+            break;
+        }
+        case 'S': {  // "C" string
+            const char* cstrp = va_arg(ap, const char*);
+            output += cstrp;
+            break;
+        }
+        case '@': {  // Verilog/C++ string
+            va_arg(ap, int);  // # bits is ignored
+            const std::string* cstrp = va_arg(ap, const std::string*);
+            output += *cstrp;
+            break;
+        }
+        case 'e':
+        case 'f':
+        case 'g':
+        case '^': {  // Realtime
+            const int lbits = va_arg(ap, int);
+            double d = va_arg(ap, double);
+            if (lbits) {}  // UNUSED - always 64
             switch (fmt) {
-            case '0': case '1': case '2': case '3': case '4':
-            case '5': case '6': case '7': case '8': case '9':
-                inPct = true;  // Get more digits
-                widthSet = true;
-                width = width*10 + (fmt - '0');
-                break;
-            case '.':
-                inPct = true;  // Get more digits
-                break;
-            case '%':
-                output += '%';
-                break;
-            case 'N': {  // "C" string with name of module, add . if needed
-                const char* cstrp = va_arg(ap, const char*);
-                if (VL_LIKELY(*cstrp)) { output += cstrp; output += '.'; }
+            case '^': {  // Realtime
+                int digits = sprintf(tmp, "%g", d/VL_TIME_MULTIPLIER);
+                int needmore = width-digits;
+                if (needmore>0) output.append(needmore, ' ');  // Pre-pad spaces
+                output += tmp;
                 break;
             }
-            case 'S': {  // "C" string
-                const char* cstrp = va_arg(ap, const char*);
-                output += cstrp;
+            default: {
+                strncpy(tmpf, pctp, speclen);
+                tmpf[speclen] = '\0';
+                sprintf(tmp, tmpf, d);
+                output += tmp;
                 break;
             }
-            case '@': {  // Verilog/C++ string
-                va_arg(ap, int);  // # bits is ignored
-                const std::string* cstrp = va_arg(ap, const std::string*);
-                output += *cstrp;
+            break;
+            }  // switch
+            break;
+        }
+        default: {
+            // Deal with all read-and-print somethings
+            const int lbits = va_arg(ap, int);
+            QData ld = 0;
+            WData qlwp[VL_WQ_WORDS_E];
+            WDataInP lwp;
+            if (lbits <= VL_QUADSIZE) {
+                ld = _VL_VA_ARG_Q(ap, lbits);
+                VL_SET_WQ(qlwp, ld);
+                lwp = qlwp;
+            } else {
+                lwp = va_arg(ap, WDataInP);
+                ld = lwp[0];
+            }
+            int lsb=lbits-1;
+            if (widthSet && width==0) while (lsb && !VL_BITISSET_W(lwp, lsb)) --lsb;
+            switch (fmt) {
+            case 'c': {
+                IData charval = ld & 0xff;
+                output += charval;
                 break;
             }
-            case 'e':
-            case 'f':
-            case 'g':
-            case '^': {  // Realtime
-                const int lbits = va_arg(ap, int);
-                double d = va_arg(ap, double);
-                if (lbits) {}  // UNUSED - always 64
-                switch (fmt) {
-                case '^': {  // Realtime
-                    int digits = sprintf(tmp, "%g", d/VL_TIME_MULTIPLIER);
-                    int needmore = width-digits;
-                    if (needmore>0) output.append(needmore, ' ');  // Pre-pad spaces
-                    output += tmp;
-                    break;
-                }
-                default: {
-                    strncpy(tmpf, pctp, pos-pctp+1);
-                    tmpf[pos-pctp+1] = '\0';
-                    sprintf(tmp, tmpf, d);
-                    output += tmp;
-                    break;
+            case 's':
+                for (; lsb>=0; --lsb) {
+                    lsb = (lsb / 8) * 8;  // Next digit
+                    IData charval = VL_BITRSHIFT_W(lwp, lsb) & 0xff;
+                    output += (charval==0)?' ':charval;
                 }
                 break;
-                }  // switch
-                break;
-            }
-            default: {
-                // Deal with all read-and-print somethings
-                const int lbits = va_arg(ap, int);
-                QData ld = 0;
-                WData qlwp[VL_WQ_WORDS_E];
-                WDataInP lwp;
+            case 'd': {  // Signed decimal
+                int digits;
+                std::string append;
                 if (lbits <= VL_QUADSIZE) {
-                    ld = _VL_VA_ARG_Q(ap, lbits);
-                    VL_SET_WQ(qlwp, ld);
-                    lwp = qlwp;
+                    digits = sprintf(tmp, "%" VL_PRI64 "d",
+                                     static_cast<vlsint64_t>(VL_EXTENDS_QQ(lbits, lbits, ld)));
+                    append = tmp;
                 } else {
-                    lwp = va_arg(ap, WDataInP);
-                    ld = lwp[0];
-                }
-                int lsb=lbits-1;
-                if (widthSet && width==0) while (lsb && !VL_BITISSET_W(lwp, lsb)) --lsb;
-                switch (fmt) {
-                case 'c': {
-                    IData charval = ld & 0xff;
-                    output += charval;
-                    break;
-                }
-                case 's':
-                    for (; lsb>=0; --lsb) {
-                        lsb = (lsb / 8) * 8;  // Next digit
-                        IData charval = VL_BITRSHIFT_W(lwp, lsb) & 0xff;
-                        output += (charval==0)?' ':charval;
-                    }
-                    break;
-                case 'd': {  // Signed decimal
-                    int digits;
-                    std::string append;
-                    if (lbits <= VL_QUADSIZE) {
-                        digits = sprintf(tmp, "%" VL_PRI64 "d",
-                                         static_cast<vlsint64_t>(VL_EXTENDS_QQ(lbits, lbits, ld)));
-                        append = tmp;
+                    if (VL_SIGN_E(lbits, lwp[VL_WORDS_I(lbits) - 1])) {
+                        WData neg[VL_VALUE_STRING_MAX_WIDTH/4+2];
+                        VL_NEGATE_W(VL_WORDS_I(lbits), neg, lwp);
+                        append = std::string("-") + VL_DECIMAL_NW(lbits, neg);
                     } else {
-                        if (VL_SIGN_E(lbits, lwp[VL_WORDS_I(lbits) - 1])) {
-                            WData neg[VL_VALUE_STRING_MAX_WIDTH/4+2];
-                            VL_NEGATE_W(VL_WORDS_I(lbits), neg, lwp);
-                            append = std::string("-") + VL_DECIMAL_NW(lbits, neg);
-                        } else {
-                            append = VL_DECIMAL_NW(lbits, lwp);
-                        }
-                        digits = append.length();
-                    }
-                    int needmore = width-digits;
-                    if (needmore>0) {
-                        if (pctp && pctp[0] && pctp[1]=='0') {  // %0
-                            output.append(needmore, '0');  // Pre-pad zero
-                        } else {
-                            output.append(needmore, ' ');  // Pre-pad spaces
-                        }
+                        append = VL_DECIMAL_NW(lbits, lwp);
                     }
-                    output += append;
-                    break;
+                    digits = append.length();
                 }
-                case '#': {  // Unsigned decimal
-                    int digits;
-                    std::string append;
-                    if (lbits <= VL_QUADSIZE) {
-                        digits = sprintf(tmp, "%" VL_PRI64 "u", ld);
-                        append = tmp;
+                int needmore = width-digits;
+                if (needmore>0) {
+                    if (zeroPad) {  // %0
+                        output.append(needmore, '0');  // Pre-pad zero
                     } else {
-                        append = VL_DECIMAL_NW(lbits, lwp);
-                        digits = append.length();
+                        output.append(needmore, ' ');  // Pre-pad spaces
                     }
-                    int needmore = width-digits;
-                    if (needmore>0) {
-                        if (pctp && pctp[0] && pctp[1]=='0') {  // %0
-                            output.append(needmore, '0');  // Pre-pad zero
-                        } else {
-                            output.append(needmore, ' ');  // Pre-pad spaces
-                        }
-                    }
-                    output += append;
-                    break;
                 }
-                case 't': {  // Time
-                    int digits;
-                    if (VL_TIME_MULTIPLIER==1) {
-                        digits=sprintf(tmp, "%" VL_PRI64 "u", ld);
-                    } else if (VL_TIME_MULTIPLIER==1000) {
-                        digits=sprintf(tmp, "%" VL_PRI64 "u.%03" VL_PRI64 "u",
-                                       static_cast<QData>(ld/VL_TIME_MULTIPLIER),
-                                       static_cast<QData>(ld%VL_TIME_MULTIPLIER));
+                output += append;
+                break;
+            }
+            case '#': {  // Unsigned decimal
+                int digits;
+                std::string append;
+                if (lbits <= VL_QUADSIZE) {
+                    digits = sprintf(tmp, "%" VL_PRI64 "u", ld);
+                    append = tmp;
+                } else {
+                    append = VL_DECIMAL_NW(lbits, lwp);
+                    digits = append.length();
+                }
+                int needmore = width-digits;
+                if (needmore>0) {
+                    if (zeroPad) {  // %0
+                        output.append(needmore, '0');  // Pre-pad zero
                     } else {
-                        VL_FATAL_MT(__FILE__, __LINE__, "", "Unsupported VL_TIME_MULTIPLIER");
+                        output.append(needmore, ' ');  // Pre-pad spaces
                     }
-                    int needmore = width-digits;
-                    if (needmore>0) output.append(needmore, ' ');  // Pre-pad spaces
-                    output += tmp;
-                    break;
                 }
-                case 'b':
-                    for (; lsb>=0; --lsb) {
-                        output += (VL_BITRSHIFT_W(lwp, lsb) & 1) + '0';
-                    }
-                    break;
-                case 'o':
-                    for (; lsb>=0; --lsb) {
-                        lsb = (lsb / 3) * 3;  // Next digit
-                        // Octal numbers may span more than one wide word,
-                        // so we need to grab each bit separately and check for overrun
-                        // Octal is rare, so we'll do it a slow simple way
-                        output += ('0'
-                                   + ((VL_BITISSETLIMIT_W(lwp, lbits, lsb+0)) ? 1 : 0)
-                                   + ((VL_BITISSETLIMIT_W(lwp, lbits, lsb+1)) ? 2 : 0)
-                                   + ((VL_BITISSETLIMIT_W(lwp, lbits, lsb+2)) ? 4 : 0));
-                    }
-                    break;
-                case 'u':  // Packed 2-state
-                    output.reserve(output.size() + 4*VL_WORDS_I(lbits));
-                    for (int i=0; i<VL_WORDS_I(lbits); ++i) {
-                        output += static_cast<char>((lwp[i]     ) & 0xff);
-                        output += static_cast<char>((lwp[i] >> 8) & 0xff);
-                        output += static_cast<char>((lwp[i] >> 16) & 0xff);
-                        output += static_cast<char>((lwp[i] >> 24) & 0xff);
-                    }
-                    break;
-                case 'z':  // Packed 4-state
-                    output.reserve(output.size() + 8*VL_WORDS_I(lbits));
-                    for (int i=0; i<VL_WORDS_I(lbits); ++i) {
-                        output += static_cast<char>((lwp[i]     ) & 0xff);
-                        output += static_cast<char>((lwp[i] >> 8) & 0xff);
-                        output += static_cast<char>((lwp[i] >> 16) & 0xff);
-                        output += static_cast<char>((lwp[i] >> 24) & 0xff);
-                        output += "\0\0\0\0";  // No tristate
-                    }
-                    break;
-                case 'v':  // Strength; assume always strong
-                    for (lsb=lbits-1; lsb>=0; --lsb) {
-                        if (VL_BITRSHIFT_W(lwp, lsb) & 1) output += "St1 ";
-                        else output += "St0 ";
-                    }
-                    break;
-                case 'x':
-                    for (; lsb>=0; --lsb) {
-                        lsb = (lsb / 4) * 4;  // Next digit
-                        IData charval = VL_BITRSHIFT_W(lwp, lsb) & 0xf;
-                        output += "0123456789abcdef"[charval];
-                    }
-                    break;
-                default:
-                    std::string msg = std::string("Unknown _vl_vsformat code: ")+pos[0];
-                    VL_FATAL_MT(__FILE__, __LINE__, "", msg.c_str());
-                    break;
-                }  // switch
+                output += append;
+                break;
+            }
+            case 't': {  // Time
+                int digits;
+                if (VL_TIME_MULTIPLIER==1) {
+                    digits=sprintf(tmp, "%" VL_PRI64 "u", ld);
+                } else if (VL_TIME_MULTIPLIER==1000) {
+                    digits=sprintf(tmp, "%" VL_PRI64 "u.%03" VL_PRI64 "u",
+                                   static_cast<QData>(ld/VL_TIME_MULTIPLIER),
+                                   static_cast<QData>(ld%VL_TIME_MULTIPLIER));
+                } else {
+                    VL_FATAL_MT(__FILE__, __LINE__, "", "Unsupported VL_TIME_MULTIPLIER");
+                }
+                int needmore = width-digits;
+                if (needmore>0) output.append(needmore, ' ');  // Pre-pad spaces
+                output += tmp;
+                break;
             }
+            case 'b':
+                for (; lsb>=0; --lsb) {
+                    output += (VL_BITRSHIFT_W(lwp, lsb) & 1) + '0';
+                }
+                break;
+            case 'o':
+                for (; lsb>=0; --lsb) {
+                    lsb = (lsb / 3) * 3;  // Next digit
+                    // Octal numbers may span more than one wide word,
+                    // so we need to grab each bit separately and check for overrun
+                    // Octal is rare, so we'll do it a slow simple way
+                    output += ('0'
+                               + ((VL_BITISSETLIMIT_W(lwp, lbits, lsb+0)) ? 1 : 0)
+                               + ((VL_BITISSETLIMIT_W(lwp, lbits, lsb+1)) ? 2 : 0)
+                               + ((VL_BITISSETLIMIT_W(lwp, lbits, lsb+2)) ? 4 : 0));
+                }
+                break;
+            case 'u':  // Packed 2-state
+                output.reserve(output.size() + 4*VL_WORDS_I(lbits));
+                for (int i=0; i<VL_WORDS_I(lbits); ++i) {
+                    output += static_cast<char>((lwp[i]     ) & 0xff);
+                    output += static_cast<char>((lwp[i] >> 8) & 0xff);
+                    output += static_cast<char>((lwp[i] >> 16) & 0xff);
+                    output += static_cast<char>((lwp[i] >> 24) & 0xff);
+                }
+                break;
+            case 'z':  // Packed 4-state
+                output.reserve(output.size() + 8*VL_WORDS_I(lbits));
+                for (int i=0; i<VL_WORDS_I(lbits); ++i) {
+                    output += static_cast<char>((lwp[i]     ) & 0xff);
+                    output += static_cast<char>((lwp[i] >> 8) & 0xff);
+                    output += static_cast<char>((lwp[i] >> 16) & 0xff);
+                    output += static_cast<char>((lwp[i] >> 24) & 0xff);
+                    output += "\0\0\0\0";  // No tristate
+                }
+                break;
+            case 'v':  // Strength; assume always strong
+                for (lsb=lbits-1; lsb>=0; --lsb) {
+                    if (VL_BITRSHIFT_W(lwp, lsb) & 1) output += "St1 ";
+                    else output += "St0 ";
+                }
+                break;
+            case 'x':
+                for (; lsb>=0; --lsb) {
+                    lsb = (lsb / 4) * 4;  // Next digit
+                    IData charval = VL_BITRSHIFT_W(lwp, lsb) & 0xf;
+                    output += "0123456789abcdef"[charval];
+                }
+                break;
+            default:
+                std::string msg = std::string("Unknown _vl_vsformat code: ")+fmt;
+                VL_FATAL_MT(__FILE__, __LINE__, "", msg.c_str());
+                break;
             }  // switch
         }
+        }  // switch
     }
 }
 
+void _vl_vsformat(std::string& output, const char* formatp, va_list ap) VL_MT_SAFE {
+    _vl_vsformat_ops(output, formatp, NULL, ap);
+}
+
 static inline bool _vl_vsss_eof(FILE* fp, int& floc) VL_MT_SAFE {
     if (fp) return feof(fp) ? 1 : 0;  // 1:0 to prevent MSVC++ warning
     else return (floc<0);
@@ -1157,16 +1199,59 @@ IData VL_FOPEN_WI(int fnwords, WDataInP filenamep, IData mode) VL_MT_SAFE {
     _VL_VINT_TO_STRING(4 * sizeof(char), modez, &modee);
     return VL_FOPEN_S(filenamez, modez);
 }
+#if defined(VL_FOPEN_COMPRESS) && !defined(_WIN32)
+static FILE* _vl_fopen_compress(const char* filenamep, const char* modep) VL_MT_SAFE {
+    // Write-only opens of *.gz or *.zst go through an external compressor
+    // Returns NULL (caller then opens normally) if not applicable
+    if (modep[0] != 'w' || strchr(modep, '+')) return NULL;
+    size_t len = strlen(filenamep);
+    const char* cmdp = NULL;
+    if (len > 3 && 0 == strcmp(filenamep + len - 3, ".gz")) cmdp = "gzip -c";
+    else if (len > 4 && 0 == strcmp(filenamep + len - 4, ".zst")) cmdp = "zstd -q -c";
+    if (!cmdp) return NULL;
+    std::string cmd = std::string(cmdp) + " > '";
+    for (const char* cp = filenamep; *cp; ++cp) {
+        if (*cp == '\'') cmd += "'\\''";
+        else cmd += *cp;
+    }
+    cmd += "'";
+    return popen(cmd.c_str(), "w");
+}
+#endif
+
 IData VL_FOPEN_S(const char* filenamep, const char* modep) VL_MT_SAFE {
-    return VerilatedImp::fdNew(fopen(filenamep, modep));
+#if defined(VL_FOPEN_COMPRESS) && !defined(_WIN32)
+    if (FILE* pipep = _vl_fopen_compress(filenamep, modep)) {
+        setvbuf(pipep, NULL, _IOFBF, VL_FOPEN_BUFFER_SIZE);
+        return VerilatedImp::fdNew(pipep, true);
+    }
+#endif
+    FILE* fp = fopen(filenamep, modep);
+    // Files being written are usually logs/traces written a line at a time;
+    // a larger buffer than stdio's default greatly reduces write(2) calls
+    if (fp && modep[0] != 'r') setvbuf(fp, NULL, _IOFBF, VL_FOPEN_BUFFER_SIZE);
+    return VerilatedImp::fdNew(fp);
 }
 
 void VL_FCLOSE_I(IData fdi) VL_MT_SAFE {
     // While threadsafe, each thread can only access different file handles
     FILE* fp = VL_CVT_I_FP(fdi);
     if (VL_UNLIKELY(!fp)) return;
-    fclose(fp);
+#if defined(VL_FOPEN_COMPRESS) && !defined(_WIN32)
+    if (VerilatedImp::fdDelete(fdi)) { pclose(fp); return; }
+#else
     VerilatedImp::fdDelete(fdi);
+#endif
+    fclose(fp);
+}
+
+static void _vl_vsformat_ops_vint(int obits, void* destp,
+                                  const VerilatedFormatOp* opsp, va_list ap) VL_MT_SAFE {
+    // Format a pre-parsed format into a Verilog variable, for VL_SFORMAT_X
+    static VL_THREAD_LOCAL std::string output;  // static only for speed
+    output = "";
+    _vl_vsformat_ops(output, NULL, opsp, ap);
+    _VL_STRING_TO_VINT(obits, destp, output.length(), output.c_str());
 }
 
 void VL_SFORMAT_X(int obits, CData& destr, const char* formatp, ...) VL_MT_SAFE {
@@ -1180,6 +1265,13 @@ void VL_SFORMAT_X(int obits, CData& destr, const char* formatp, ...) VL_MT_SAFE
     _VL_STRING_TO_VINT(obits, &destr, output.length(), output.c_str());
 }
 
+void VL_SFORMAT_X(int obits, CData& destr, const VerilatedFormatOp* opsp, ...) VL_MT_SAFE {
+    va_list ap;
+    va_start(ap, opsp);
+    _vl_vsformat_ops_vint(obits, &destr, opsp, ap);
+    va_end(ap);
+}
+
 void VL_SFORMAT_X(int obits, SData& destr, const char* formatp, ...) VL_MT_SAFE {
     static VL_THREAD_LOCAL std::string output;  // static only for speed
     output = "";
@@ -1191,6 +1283,13 @@ void VL_SFORMAT_X(int obits, SData& destr, const char* formatp, ...) VL_MT_SAFE
     _VL_STRING_TO_VINT(obits, &destr, output.length(), output.c_str());
 }
 
+void VL_SFORMAT_X(int obits, SData& destr, const VerilatedFormatOp* opsp, ...) VL_MT_SAFE {
+    va_list ap;
+    va_start(ap, opsp);
+    _vl_vsformat_ops_vint(obits, &destr, opsp, ap);
+    va_end(ap);
+}
+
 void VL_SFORMAT_X(int obits, IData& destr, const char* formatp, ...) VL_MT_SAFE {
     static VL_THREAD_LOCAL std::string output;  // static only for speed
     output = "";
@@ -1202,6 +1301,13 @@ void VL_SFORMAT_X(int obits, IData& destr, const char* formatp, ...) VL_MT_SAFE
     _VL_STRING_TO_VINT(obits, &destr, output.length(), output.c_str());
 }
 
+void VL_SFORMAT_X(int obits, IData& destr, const VerilatedFormatOp* opsp, ...) VL_MT_SAFE {
+    va_list ap;
+    va_start(ap, opsp);
+    _vl_vsformat_ops_vint(obits, &destr, opsp, ap);
+    va_end(ap);
+}
+
 void VL_SFORMAT_X(int obits, QData& destr, const char* formatp, ...) VL_MT_SAFE {
     static VL_THREAD_LOCAL std::string output;  // static only for speed
     output = "";
@@ -1213,6 +1319,13 @@ void VL_SFORMAT_X(int obits, QData& destr, const char* formatp, ...) VL_MT_SAFE
     _VL_STRING_TO_VINT(obits, &destr, output.length(), output.c_str());
 }
 
+void VL_SFORMAT_X(int obits, QData& destr, const VerilatedFormatOp* opsp, ...) VL_MT_SAFE {
+    va_list ap;
+    va_start(ap, opsp);
+    _vl_vsformat_ops_vint(obits, &destr, opsp, ap);
+    va_end(ap);
+}
+
 void VL_SFORMAT_X(int obits, void* destp, const char* formatp, ...) VL_MT_SAFE {
     static VL_THREAD_LOCAL std::string output;  // static only for speed
     output = "";
@@ -1224,6 +1337,13 @@ void VL_SFORMAT_X(int obits, void* destp, const char* formatp, ...) VL_MT_SAFE {
     _VL_STRING_TO_VINT(obits, destp, output.length(), output.c_str());
 }
 
+void VL_SFORMAT_X(int obits, void* destp, const VerilatedFormatOp* opsp, ...) VL_MT_SAFE {
+    va_list ap;
+    va_start(ap, opsp);
+    _vl_vsformat_ops_vint(obits, destp, opsp, ap);
+    va_end(ap);
+}
+
 void VL_SFORMAT_X(int obits_ignored, std::string &output, const char* formatp, ...) VL_MT_SAFE {
     if (obits_ignored) {}
     output = "";
@@ -1233,6 +1353,16 @@ void VL_SFORMAT_X(int obits_ignored, std::string &output, const char* formatp, .
     va_end(ap);
 }
 
+void VL_SFORMAT_X(int obits_ignored, std::string &output,
+                  const VerilatedFormatOp* opsp, ...) VL_MT_SAFE {
+    if (obits_ignored) {}
+    output = "";
+    va_list ap;
+    va_start(ap, opsp);
+    _vl_vsformat_ops(output, NULL, opsp, ap);
+    va_end(ap);
+}
+
 std::string VL_SFORMATF_NX(const char* formatp, ...) VL_MT_SAFE {
     static VL_THREAD_LOCAL std::string output;  // static only for speed
     output = "";
@@ -1255,6 +1385,17 @@ void VL_WRITEF(const char* formatp, ...) VL_MT_SAFE {
     VL_PRINTF_MT("%s", output.c_str());
 }
 
+void VL_WRITEF(const VerilatedFormatOp* opsp, ...) VL_MT_SAFE {
+    static VL_THREAD_LOCAL std::string output;  // static only for speed
+    output = "";
+    va_list ap;
+    va_start(ap, opsp);
+    _vl_vsformat_ops(output, NULL, opsp, ap);
+    va_end(ap);
+
+    VL_PRINTF_MT("%s", output.c_str());
+}
+
 void VL_FWRITEF(IData fpi, const char* formatp, ...) VL_MT_SAFE {
     // While threadsafe, each thread can only access different file handles
     static VL_THREAD_LOCAL std::string output;  // static only for speed
@@ -1267,7 +1408,22 @@ void VL_FWRITEF(IData fpi, const char* formatp, ...) VL_MT_SAFE {
     _vl_vsformat(output, formatp, ap);
     va_end(ap);
 
-    fputs(output.c_str(), fp);
+    fwrite(output.data(), 1, output.size(), fp);
+}
+
+void VL_FWRITEF(IData fpi, const VerilatedFormatOp* opsp, ...) VL_MT_SAFE {
+    // While threadsafe, each thread can only access different file handles
+    static VL_THREAD_LOCAL std::string output;  // static only for speed
+    output = "";
+    FILE* fp = VL_CVT_I_FP(fpi);
+    if (VL_UNLIKELY(!fp)) return;
+
+    va_list ap;
+    va_start(ap, opsp);
+    _vl_vsformat_ops(output, NULL, opsp, ap);
+    va_end(ap);
+
+    fwrite(output.data(), 1, output.size(), fp);
 }
 
 IData VL_FSCANF_IX(IData fpi, const char* formatp, ...) VL_MT_SAFE {
@@ -1522,6 +1678,219 @@ void VL_READMEM_W(bool hex, int width, int depth, int array_lsb, int fnwords,
     return VL_READMEM_N(hex, width, depth, array_lsb, filenames, memp, start, end);
 }
 
+//===========================================================================
+// Readmem internals
+
+/// Entire contents of a memory file, mapped (or read) in one operation
+/// rather than a character at a time through stdio
+class VlReadMemFile {
+    const char* m_datap;  ///< File contents
+    size_t m_size;  ///< File size in bytes
+    bool m_mapped;  ///< m_datap is mmapped, else new[]ed
+public:
+    VlReadMemFile() : m_datap(NULL), m_size(0), m_mapped(false) {}
+    ~VlReadMemFile() { close(); }
+private:
+    VL_UNCOPYABLE(VlReadMemFile);
+public:
+    const char* data() const { return m_datap; }
+    size_t size() const { return m_size; }
+    /// Load given file, return false if cannot be opened
+    bool open(const std::string& filename) {
+#if !defined(_WIN32) && !defined(__MINGW32__)
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat sb;
+        if (fstat(fd, &sb) == 0 && S_ISREG(sb.st_mode)) {
+            m_size = static_cast<size_t>(sb.st_size);
+            if (m_size == 0) { ::close(fd); return true; }
+            void* mapp = mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapp != MAP_FAILED) {
+                ::close(fd);
+# ifdef MADV_SEQUENTIAL
+                madvise(mapp, m_size, MADV_SEQUENTIAL);
+# endif
+                m_datap = reinterpret_cast<const char*>(mapp);
+                m_mapped = true;
+                return true;
+            }
+        }
+        ::close(fd);
+#endif
+        // Not a regular file, or can't map it; fall back to reading it all in
+        FILE* fp = fopen(filename.c_str(), "rb");
+        if (VL_UNLIKELY(!fp)) return false;
+        std::string contents;
+        char buf[64 * 1024];
+        while (size_t got = fread(buf, 1, sizeof(buf), fp)) contents.append(buf, got);
+        fclose(fp);
+        m_size = contents.size();
+        char* datap = new char[m_size + 1];
+        memcpy(datap, contents.data(), m_size);
+        m_datap = datap;
+        return true;
+    }
+    void close() {
+#if !defined(_WIN32) && !defined(__MINGW32__)
+        if (m_mapped) munmap(const_cast<char*>(m_datap), m_size);
+#endif
+        if (!m_mapped) delete[] m_datap;
+        m_datap = NULL;
+        m_size = 0;
+        m_mapped = false;
+    }
+};
+
+/// Store a number whose digits span [tokp, endp) into the memory row
+/// Returns false if a binary file contained a hex digit
+static bool _vl_readmem_store(bool hex, int width, void* memp, int entry,
+                              const char* tokp, const char* endp) VL_MT_SAFE {
+    // Converting the whole number at once, least significant digit first,
+    // avoids shifting a wide row per digit.  Digits beyond the row width
+    // are dropped, as if each had been shifted in from the right.
+    const int shift = hex ? 4 : 1;
+    QData qvalue = 0;
+    WDataOutP wdatap = NULL;
+    if (width > VL_QUADSIZE) {
+        wdatap = &(reinterpret_cast<WDataOutP>(memp))[entry * VL_WORDS_I(width)];
+        VL_ZERO_RESET_W(width, wdatap);
+    }
+    int lsb = 0;
+    for (const char* cp = endp - 1; cp >= tokp; --cp) {
+        int c = *cp;
+        if (!isxdigit(c) && c != 'x' && c != 'X') continue;  // '_' or comment slash
+        c = tolower(c);
+        IData value = (c >= 'a' ? (c == 'x' ? VL_RAND_RESET_I(shift) : (c - 'a' + 10))
+                       : (c - '0'));
+        if (VL_UNLIKELY(value >= (1U << shift))) return false;
+        if (lsb < width) {
+            // Digits never straddle words, as shift divides VL_EDATASIZE
+            if (wdatap) {
+                wdatap[VL_BITWORD_E(lsb)] |= static_cast<EData>(value) << VL_BITBIT_E(lsb);
+            } else {
+                qvalue |= static_cast<QData>(value) << static_cast<QData>(lsb);
+            }
+        }
+        lsb += shift;
+    }
+    if (wdatap) wdatap[VL_WORDS_I(width) - 1] &= VL_MASK_E(width);
+    if (width <= 8) {
+        reinterpret_cast<CData*>(memp)[entry] = static_cast<CData>(qvalue & VL_MASK_I(width));
+    } else if (width <= 16) {
+        reinterpret_cast<SData*>(memp)[entry] = static_cast<SData>(qvalue & VL_MASK_I(width));
+    } else if (width <= VL_IDATASIZE) {
+        reinterpret_cast<IData*>(memp)[entry] = static_cast<IData>(qvalue & VL_MASK_I(width));
+    } else if (width <= VL_QUADSIZE) {
+        reinterpret_cast<QData*>(memp)[entry] = qvalue & VL_MASK_Q(width);
+    }
+    return true;
+}
+
+#ifdef VL_THREADED
+/// Minimum bytes of memory file per thread when loading in parallel
+# define VL_READMEM_PARALLEL_CHUNK (4 * 1024 * 1024)
+
+/// Return if file contains only digits and whitespace, so can be split at
+/// any line boundary and parsed in parallel
+static bool _vl_readmem_dense(bool hex, const char* datap, const char* endp) VL_MT_SAFE {
+    for (const char* cp = datap; cp < endp; ++cp) {
+        const char c = *cp;
+        if (c == '0' || c == '1' || c == '\n' || c == ' ' || c == '\t' || c == '\r') continue;
+        if (hex && isxdigit(c)) continue;
+        return false;
+    }
+    return true;
+}
+
+/// Count whitespace separated numbers, and newlines, in a dense chunk
+static IData _vl_readmem_dense_count(const char* datap, const char* endp,
+                                     int& newlines) VL_MT_SAFE {
+    IData count = 0;
+    bool innum = false;
+    for (const char* cp = datap; cp < endp; ++cp) {
+        bool digit = !isspace(*cp);
+        if (digit && !innum) ++count;
+        if (*cp == '\n') ++newlines;
+        innum = digit;
+    }
+    return count;
+}
+
+/// Parse a dense chunk whose first number goes into the given entry
+static void _vl_readmem_dense_parse(bool hex, int width, void* memp, int entry,
+                                    const char* datap, const char* endp) VL_MT_SAFE {
+    const char* cp = datap;
+    while (cp < endp) {
+        while (cp < endp && isspace(*cp)) ++cp;
+        const char* tokp = cp;
+        while (cp < endp && !isspace(*cp)) ++cp;
+        if (tokp != cp) _vl_readmem_store(hex, width, memp, entry++, tokp, cp);
+    }
+}
+
+/// Load a large dense memory file using multiple threads
+/// Return false if file is not suitable, and the serial loader should be used.
+/// Files that would load beyond the array are also left to the serial
+/// loader, so the error reports the line of the first bad number.
+static bool _vl_readmem_parallel(bool hex, int width, int depth, int array_lsb,
+                                 const VlReadMemFile& file,
+                                 void* memp, IData& addr, int& linenum) VL_MT_SAFE {
+    const char* const datap = file.data();
+    const char* const endp = datap + file.size();
+    size_t nthreads = std::thread::hardware_concurrency();
+    nthreads = std::min(nthreads, file.size() / VL_READMEM_PARALLEL_CHUNK);
+    if (nthreads < 2) return false;
+    if (!_vl_readmem_dense(hex, datap, endp)) return false;
+    // Split into chunks at line boundaries
+    std::vector<const char*> bounds;
+    bounds.push_back(datap);
+    for (size_t i = 1; i < nthreads; ++i) {
+        const char* cp = std::max(bounds.back(), datap + (file.size() * i) / nthreads);
+        while (cp < endp && *cp != '\n') ++cp;
+        bounds.push_back(cp);
+    }
+    bounds.push_back(endp);
+    // First pass counts numbers in each chunk, giving each chunk's starting row
+    std::vector<IData> counts(nthreads);
+    std::vector<int> newlines(nthreads);
+    {
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < nthreads; ++i) {
+            threads.push_back(std::thread([&counts, &newlines, &bounds, i]() {
+                counts[i] = _vl_readmem_dense_count(bounds[i], bounds[i + 1], newlines[i]);
+            }));
+        }
+        for (size_t i = 0; i < nthreads; ++i) threads[i].join();
+    }
+    std::vector<int> entries(nthreads);
+    QData total = 0;  // 64 bits, so addr + total can't wrap
+    int lines = 0;
+    for (size_t i = 0; i < nthreads; ++i) {
+        entries[i] = static_cast<int>(addr + total - array_lsb);
+        total += counts[i];
+        lines += newlines[i];
+    }
+    if (VL_UNLIKELY(total && (addr < static_cast<IData>(array_lsb)
+                              || (static_cast<QData>(addr) + total)
+                              > static_cast<QData>(static_cast<IData>(depth + array_lsb))))) {
+        return false;
+    }
+    // Second pass converts each chunk into its rows
+    {
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < nthreads; ++i) {
+            threads.push_back(std::thread([=, &bounds, &entries]() {
+                _vl_readmem_dense_parse(hex, width, memp, entries[i], bounds[i], bounds[i + 1]);
+            }));
+        }
+        for (size_t i = 0; i < nthreads; ++i) threads[i].join();
+    }
+    addr += static_cast<IData>(total);
+    linenum += lines;
+    return true;
+}
+#endif  // VL_THREADED
+
 void VL_READMEM_N(
     bool hex,  // Hex format, else binary
     int width,  // Width of each array row
@@ -1533,113 +1902,113 @@ void VL_READMEM_N(
     IData start,  // First array row address to read
     IData end  // Last row address to read
     ) VL_MT_SAFE {
-    FILE* fp = fopen(filename.c_str(), "r");
-    if (VL_UNLIKELY(!fp)) {
+    VlReadMemFile file;
+    if (VL_UNLIKELY(!file.open(filename))) {
         // We don't report the Verilog source filename as it slow to have to pass it down
         VL_FATAL_MT(filename.c_str(), 0, "", "$readmem file not found");
-        // cppcheck-suppress resourceLeak  // fp is NULL - bug in cppcheck
         return;
     }
     // Prep for reading
     IData addr = start;
     int linenum = 1;
-    bool innum = false;
-    bool ignore_to_eol = false;
-    bool ignore_to_cmt = false;
-    bool needinc = false;
-    bool reading_addr = false;
-    int lastc = ' ';
-    // Read the data
-    // We process a character at a time, as then we don't need to deal
-    // with changing buffer sizes dynamically, etc.
-    while (1) {
-        int c = fgetc(fp);
-        if (VL_UNLIKELY(c==EOF)) break;
-        //printf("%d: Got '%c' Addr%x IN%d IgE%d IgC%d ninc%d\n",
-        //       linenum, c, addr, innum, ignore_to_eol, ignore_to_cmt, needinc);
-        if (c=='\n') {
-            linenum++; ignore_to_eol = false;
-            if (innum) reading_addr = false;
-            innum = false;
-        }
-        else if (c=='\t' || c==' ' || c=='\r' || c=='\f') {
-            if (innum) reading_addr = false;
-            innum = false;
-        }
-        // Skip // comments and detect /* comments
-        else if (ignore_to_cmt && lastc=='*' && c=='/') {
-            ignore_to_cmt = false; if (innum) reading_addr=false; innum=false;
-        } else if (!ignore_to_eol && !ignore_to_cmt) {
-            if (lastc=='/' && c=='*') { ignore_to_cmt = true; }
-            else if (lastc=='/' && c=='/') { ignore_to_eol = true; }
-            else if (c=='/') {}  // Part of /* or //
-            else if (c=='#') { ignore_to_eol = true; }
-            else if (c=='_') {}
-            else if (c=='@') { reading_addr = true; innum=false; needinc=false; }
-            // Check for hex or binary digits as file format requests
-            else if (isxdigit(c) || (!reading_addr && (c=='x' || c=='X'))) {
-                c = tolower(c);
-                int value = (c >= 'a' ? (c=='x' ? VL_RAND_RESET_I(4) : (c-'a'+10)) : (c-'0'));
-                if (!innum) {  // Prep for next number
-                    if (needinc) { addr++; needinc=false; }
+#ifdef VL_THREADED
+    if (!_vl_readmem_parallel(hex, width, depth, array_lsb, file, memp, addr, linenum))
+#endif
+    {
+        bool innum = false;
+        bool ignore_to_eol = false;
+        bool ignore_to_cmt = false;
+        bool needinc = false;
+        bool reading_addr = false;
+        const char* tokp = NULL;  // Start of pending data number
+        const char* tokendp = NULL;  // End of pending data number
+        IData tokaddr = 0;  // Address of pending data number
+        int toklinenum = 0;  // Line of pending data number
+        int lastc = ' ';
+        // Read the data
+        // We process a character at a time, as then we don't need to deal
+        // with changing buffer sizes dynamically, etc.
+        // Each data number is converted when the next begins, or at end of file.
+        const char* const endp = file.data() + file.size();
+        for (const char* cp = file.data(); ; ++cp) {
+            const int c = (cp < endp) ? *cp : EOF;
+            if (tokp && (c == EOF || (!innum && !reading_addr && !ignore_to_eol
+                                      && !ignore_to_cmt
+                                      && (isxdigit(c) || c == 'x' || c == 'X')))) {
+                if (VL_UNLIKELY(!_vl_readmem_store(hex, width, memp, tokaddr - array_lsb,
+                                                   tokp, tokendp))) {
+                    VL_FATAL_MT(filename.c_str(), toklinenum, "",
+                                "$readmemb (binary) file contains hex characters");
                 }
-                if (reading_addr) {
-                    // Decode @ addresses
-                    if (!innum) addr=0;
-                    addr = (addr<<4) + value;
-                } else {
-                    needinc = true;
-                    //printf(" Value width=%d  @%x = %c\n", width, addr, c);
-                    if (VL_UNLIKELY(addr >= static_cast<IData>(depth+array_lsb)
-                                    || addr < static_cast<IData>(array_lsb))) {
-                        VL_FATAL_MT(filename.c_str(), linenum, "",
-                                    "$readmem file address beyond bounds of array");
+                tokp = NULL;
+            }
+            if (VL_UNLIKELY(c == EOF)) break;
+            //printf("%d: Got '%c' Addr%x IN%d IgE%d IgC%d ninc%d\n",
+            //       linenum, c, addr, innum, ignore_to_eol, ignore_to_cmt, needinc);
+            if (c=='\n') {
+                linenum++; ignore_to_eol = false;
+                if (innum) reading_addr = false;
+                innum = false;
+            }
+            else if (c=='\t' || c==' ' || c=='\r' || c=='\f') {
+                if (innum) reading_addr = false;
+                innum = false;
+            }
+            // Skip // comments and detect /* comments
+            else if (ignore_to_cmt && lastc=='*' && c=='/') {
+                ignore_to_cmt = false; if (innum) reading_addr=false; innum=false;
+            } else if (!ignore_to_eol && !ignore_to_cmt) {
+                if (lastc=='/' && c=='*') { ignore_to_cmt = true; }
+                else if (lastc=='/' && c=='/') { ignore_to_eol = true; }
+                else if (c=='/') {}  // Part of /* or //
+                else if (c=='#') { ignore_to_eol = true; }
+                else if (c=='_') {}
+                else if (c=='@') { reading_addr = true; innum=false; needinc=false; }
+                // Check for hex or binary digits as file format requests
+                else if (isxdigit(c) || (!reading_addr && (c=='x' || c=='X'))) {
+                    if (!innum) {  // Prep for next number
+                        if (needinc) { addr++; needinc=false; }
+                    }
+                    if (reading_addr) {
+                        // Decode @ addresses
+                        int lc = tolower(c);
+                        int value = (lc >= 'a' ? (lc-'a'+10) : (lc-'0'));
+                        if (!innum) addr=0;
+                        addr = (addr<<4) + value;
                     } else {
-                        int entry = addr - array_lsb;
-                        QData shift = hex ? VL_ULL(4) : VL_ULL(1);
-                        // Shift value in
-                        if (width<=8) {
-                            CData* datap = &(reinterpret_cast<CData*>(memp))[entry];
-                            if (!innum) { *datap = 0; }
-                            *datap = ((*datap << shift) + value) & VL_MASK_I(width);
-                        } else if (width<=16) {
-                            SData* datap = &(reinterpret_cast<SData*>(memp))[entry];
-                            if (!innum) { *datap = 0; }
-                            *datap = ((*datap << shift) + value) & VL_MASK_I(width);
-                        } else if (width <= VL_IDATASIZE) {
-                            IData* datap = &(reinterpret_cast<IData*>(memp))[entry];
-                            if (!innum) { *datap = 0; }
-                            *datap = ((*datap << shift) + value) & VL_MASK_I(width);
-                        } else if (width<=VL_QUADSIZE) {
-                            QData* datap = &(reinterpret_cast<QData*>(memp))[entry];
-                            if (!innum) { *datap = 0; }
-                            *datap = ((*datap << static_cast<QData>(shift))
-                                      + static_cast<QData>(value)) & VL_MASK_Q(width);
-                        } else {
-                            WDataOutP datap = &(reinterpret_cast<WDataOutP>(memp))
-                                [ entry*VL_WORDS_I(width) ];
-                            if (!innum) { VL_ZERO_RESET_W(width, datap); }
-                            _VL_SHIFTL_INPLACE_W(width, datap, static_cast<IData>(shift));
-                            datap[0] |= value;
-                        }
-                        if (VL_UNLIKELY(value>=(1<<shift))) {
+                        needinc = true;
+                        //printf(" Value width=%d  @%x = %c\n", width, addr, c);
+                        if (VL_UNLIKELY(addr >= static_cast<IData>(depth+array_lsb)
+                                        || addr < static_cast<IData>(array_lsb))) {
                             VL_FATAL_MT(filename.c_str(), linenum, "",
-                                        "$readmemb (binary) file contains hex characters");
+                                        "$readmem file address beyond bounds of array");
+                        } else {
+                            if (!tokp) {
+                                tokp = cp;
+                                tokaddr = addr;
+                                toklinenum = linenum;
+                            }
+                            // Fast path: consume the remaining digits without the
+                            // state machine above, as they can't change any state
+                            while ((cp + 1) < endp && (isxdigit(cp[1]) || cp[1] == '_'
+                                                       || cp[1] == 'x' || cp[1] == 'X')) {
+                                ++cp;
+                            }
+                            tokendp = cp + 1;
                         }
                     }
+                    innum = true;
+                }
+                else {
+                    VL_FATAL_MT(filename.c_str(), linenum, "", "$readmem file syntax error");
                 }
-                innum = true;
-            }
-            else {
-                VL_FATAL_MT(filename.c_str(), linenum, "", "$readmem file syntax error");
             }
+            lastc = *cp;
         }
-        lastc = c;
+        if (needinc) { addr++; }
     }
-    if (needinc) { addr++; }
 
     // Final checks
-    fclose(fp);
     if (VL_UNLIKELY(end != VL_UL(0xffffffff) && addr != (end+1))) {
         VL_FATAL_MT(filename.c_str(), linenum, "",
                     "$readmem file ended before specified ending-address");
@@ -1886,6 +2255,74 @@ int VL_TIME_STR_CONVERT(const char* strp) {
     return scale;
 }
 
+//===========================================================================
+// VerilatedContext:: Methods
+
+VerilatedContext::VerilatedContext()
+    : m_time(0), m_gotFinish(false), m_assertOn(true), m_randSeed(0)
+    , m_argc(0), m_argv(NULL), m_randSeeded(false) {
+    m_scopeNameMapp = new VerilatedScopeNameMap;
+}
+VerilatedContext::~VerilatedContext() {
+    // Models must be deleted before their context
+    delete m_scopeNameMapp; m_scopeNameMapp = NULL;
+}
+
+void VerilatedContext::gotFinish(bool flag) VL_MT_SAFE {
+    VerilatedLockGuard lock(m_mutex);
+    m_gotFinish = flag;
+}
+void VerilatedContext::assertOn(bool flag) VL_MT_SAFE {
+    VerilatedLockGuard lock(m_mutex);
+    m_assertOn = flag;
+}
+void VerilatedContext::randSeed(int val) VL_MT_SAFE {
+    VerilatedLockGuard lock(m_mutex);
+    m_randSeed = val;
+    m_randSeeded = false;
+}
+vluint64_t VerilatedContext::rand64() VL_MT_SAFE {
+    // Threads evaluating the context share one sequence
+    VerilatedLockGuard lock(m_mutex);
+    if (VL_UNLIKELY(!m_randSeeded)) {
+        m_randSeeded = true;
+        vl_rand_seed(m_randState, m_randSeed ? m_randSeed : Verilated::randSeed());
+    }
+    return vl_rand_next(m_randState);
+}
+void VerilatedContext::commandArgs(int argc, const char** argv) VL_MT_SAFE {
+    VerilatedLockGuard lock(m_mutex);
+    m_argc = argc;
+    m_argv = argv;
+}
+void VerilatedContext::scopeInsert(const VerilatedScope* scopep) VL_MT_SAFE {
+    // Slow ok - called once/scope at construction
+    VerilatedLockGuard lock(m_mutex);
+    VerilatedScopeNameMap::iterator it = m_scopeNameMapp->find(scopep->name());
+    if (it == m_scopeNameMapp->end()) {
+        m_scopeNameMapp->insert(it, std::make_pair(scopep->name(), scopep));
+    }
+}
+void VerilatedContext::scopeErase(const VerilatedScope* scopep) VL_MT_SAFE {
+    // Slow ok - called once/scope at destruction
+    VerilatedLockGuard lock(m_mutex);
+    VerilatedScopeNameMap::iterator it = m_scopeNameMapp->find(scopep->name());
+    if (it != m_scopeNameMapp->end() && it->second == scopep) m_scopeNameMapp->erase(it);
+}
+const VerilatedScope* VerilatedContext::scopeFind(const char* namep) VL_MT_SAFE {
+    VerilatedLockGuard lock(m_mutex);
+    VerilatedScopeNameMap::const_iterator it = m_scopeNameMapp->find(namep);
+    if (VL_LIKELY(it != m_scopeNameMapp->end())) return it->second;
+    else return NULL;
+}
+void VerilatedContext::scopesDump() VL_MT_SAFE {
+    VerilatedLockGuard lock(m_mutex);
+    for (VerilatedScopeNameMap::const_iterator it = m_scopeNameMapp->begin();
+         it != m_scopeNameMapp->end(); ++it) {
+        it->second->scopeDump();
+    }
+}
+
 //===========================================================================
 // Verilated:: Methods
 
@@ -1895,6 +2332,7 @@ Verilated::ThreadLocal::ThreadLocal()
     t_mtaskId(0),
     t_endOfEvalReqd(0),
 #endif
+    t_contextp(NULL),
     t_dpiScopep(NULL), t_dpiFilename(0), t_dpiLineno(0) {
 }
 Verilated::ThreadLocal::~ThreadLocal() {
@@ -1939,10 +2377,12 @@ void Verilated::errorLimit(int val) VL_MT_SAFE {
     s_s.s_errorLimit = val;
 }
 void Verilated::gotFinish(bool flag) VL_MT_SAFE {
+    if (VL_UNLIKELY(t_s.t_contextp)) { t_s.t_contextp->gotFinish(flag); return; }
     VerilatedLockGuard lock(m_mutex);
     s_s.s_gotFinish = flag;
 }
 void Verilated::assertOn(bool flag) VL_MT_SAFE {
+    if (VL_UNLIKELY(t_s.t_contextp)) { t_s.t_contextp->assertOn(flag); return; }
     VerilatedLockGuard lock(m_mutex);
     s_s.s_assertOn = flag;
 }
@@ -2183,6 +2623,8 @@ VerilatedSyms::VerilatedSyms() {
 #ifdef VL_THREADED
     __Vm_evalMsgQp = new VerilatedEvalMsgQueue;
 #endif
+    // Constructed by the model's constructor, after it set its context
+    __Vm_contextp = Verilated::threadContextp();
 }
 VerilatedSyms::~VerilatedSyms() {
 #ifdef VL_THREADED
@@ -2221,24 +2663,23 @@ vluint32_t VerilatedVarProps::entSize() const {
     return size;
 }
 
-size_t VerilatedVarProps::totalSize() const {
-    size_t size = entSize();
-    for (int dim=1; dim<=dims(); ++dim) {
-        size *= m_unpacked[dim].elements();
+void VerilatedVarProps::initStrides() {
+    // Innermost (highest numbered) dimension is contiguous elements
+    size_t slicesz = entSize();
+    for (int d=3; d>=1; --d) {
+        if (d <= m_udims) {
+            m_strides[d-1] = slicesz;
+            slicesz *= m_unpacked[d-1].elements();
+        } else {
+            m_strides[d-1] = 0;
+        }
     }
-    return size;
 }
 
-void* VerilatedVarProps::datapAdjustIndex(void* datap, int dim, int indx) const {
-    if (VL_UNLIKELY(dim <=0 || dim > m_udims || dim > 3)) return NULL;
-    if (VL_UNLIKELY(indx < low(dim) || indx > high(dim))) return NULL;
-    int indxAdj = indx - low(dim);
-    vluint8_t* bytep = reinterpret_cast<vluint8_t*>(datap);
-    // If on index 1 of a 2 index array, then each index 1 is index2sz*entsz
-    size_t slicesz = entSize();
-    for (int d=dim+1; d<=m_udims; ++d) slicesz *= elements(d);
-    bytep += indxAdj*slicesz;
-    return bytep;
+size_t VerilatedVarProps::totalSize() const {
+    size_t size = entSize();
+    if (m_udims >= 1) size = m_strides[0] * m_unpacked[0].elements();
+    return size;
 }
 
 //======================================================================
@@ -2330,6 +2771,7 @@ void VerilatedScope::varInsert(int finalize, const char* namep, void* datap,
         }
     }
     va_end(ap);
+    var.initStrides();
 
     m_varsp->insert(std::make_pair(namep, var));
 }
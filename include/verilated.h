@@ -77,6 +77,7 @@ typedef void (*VerilatedVoidCb)(void);
 
 class SpTraceVcd;
 class SpTraceVcdCFile;
+class VerilatedContext;
 class VerilatedEvalMsgQueue;
 class VerilatedScopeNameMap;
 class VerilatedVar;
@@ -286,6 +287,7 @@ public:  // But for internal use only
 #ifdef VL_THREADED
     VerilatedEvalMsgQueue* __Vm_evalMsgQp;
 #endif
+    VerilatedContext* __Vm_contextp;  ///< Simulation context, or NULL for global
     VerilatedSyms();
     ~VerilatedSyms();
 };
@@ -344,6 +346,74 @@ public:
     void add(VerilatedScope* fromp, VerilatedScope* top);
 };
 
+//===========================================================================
+/// Verilator simulation context
+/// Holds the state that must differ between independent simulations running
+/// in one process, e.g. several seeds of a model, each on its own thread.
+/// Pass a context to the model's constructor; models constructed without
+/// one use the Verilated:: global state.  Each model already has its own
+/// thread pool and message queue.  While a model with a context is
+/// constructed or evaluated, Verilated::gotFinish(), assertOn(), $time,
+/// the random seed and $test$plusargs/$value$plusargs refer to that context.
+
+class VerilatedContext {
+    // MEMBERS
+    VerilatedMutex m_mutex;  ///< Protect writes to members
+#ifdef VL_THREADED
+    std::atomic<vluint64_t> m_time;  ///< Current simulation time, in the units of sc_time_stamp()
+#else
+    vluint64_t m_time;  ///< Current simulation time, in the units of sc_time_stamp()
+#endif
+    bool m_gotFinish;  ///< A $finish statement executed
+    bool m_assertOn;  ///< Assertions are enabled
+    int m_randSeed;  ///< Random seed: 0=use Verilated::randSeed()
+    int m_argc;  ///< Command line, or 0 to use Verilated::commandArgs()
+    const char** m_argv;  ///< Command line (owned by caller)
+    bool m_randSeeded;  ///< m_randState is seeded
+    vluint64_t m_randState[2];  ///< Random number generator state
+    VerilatedScopeNameMap* m_scopeNameMapp;  ///< Scopes of this context's models
+
+private:
+    VL_UNCOPYABLE(VerilatedContext);
+public:
+    // CONSTRUCTORS
+    VerilatedContext();
+    ~VerilatedContext();
+
+    // METHODS - User called
+    /// Simulation time, which application code must advance; returned by $time
+    vluint64_t time() const VL_MT_SAFE { return m_time; }
+    void time(vluint64_t value) VL_MT_SAFE { m_time = value; }
+    void timeInc(vluint64_t add) VL_MT_SAFE { m_time += add; }
+    /// Did the simulation $finish?
+    bool gotFinish() const VL_MT_SAFE { return m_gotFinish; }
+    void gotFinish(bool flag) VL_MT_SAFE;
+    /// Enable/disable assertions
+    bool assertOn() const VL_MT_SAFE { return m_assertOn; }
+    void assertOn(bool flag) VL_MT_SAFE;
+    /// Random seed for this context's $random/$urandom; 0 = use Verilated::randSeed()
+    /// Must be set before the model is constructed.
+    int randSeed() const VL_MT_SAFE { return m_randSeed; }
+    void randSeed(int val) VL_MT_SAFE;
+    /// Record command line arguments for this context's $test$plusargs/$value$plusargs.
+    /// The arguments are not copied, and must remain valid for the life of the context.
+    void commandArgs(int argc, const char** argv) VL_MT_SAFE;
+    void commandArgs(int argc, char** argv) VL_MT_SAFE {
+        commandArgs(argc, const_cast<const char**>(argv)); }
+    int argc() const VL_MT_SAFE { return m_argc; }
+    const char** argv() const VL_MT_SAFE { return m_argv; }
+
+    // METHODS - Internal
+    /// Next number from this context's random number generator
+    vluint64_t rand64() VL_MT_SAFE;
+    /// Scopes by name, for models constructed with this context
+    void scopeInsert(const VerilatedScope* scopep) VL_MT_SAFE;
+    void scopeErase(const VerilatedScope* scopep) VL_MT_SAFE;
+    const VerilatedScope* scopeFind(const char* namep) VL_MT_SAFE;
+    void scopesDump() VL_MT_SAFE;
+    const VerilatedScopeNameMap* scopeNameMap() VL_MT_SAFE_POSTINIT { return m_scopeNameMapp; }
+};
+
 //===========================================================================
 /// Verilator global static information class
 
@@ -397,6 +467,7 @@ class Verilated {
         vluint32_t t_mtaskId;  ///< Current mtask# executing on this thread
         vluint32_t t_endOfEvalReqd;  ///< Messages may be pending, thread needs endOf-eval calls
 #endif
+        VerilatedContext* t_contextp;  ///< Context of model being constructed/evaluated
         const VerilatedScope* t_dpiScopep;  ///< DPI context scope
         const char* t_dpiFilename;  ///< DPI context filename
         int t_dpiLineno;  ///< DPI context line number
@@ -445,14 +516,18 @@ public:
     static int errorLimit() VL_MT_SAFE { return s_s.s_errorLimit; }
     /// Did the simulation $finish?
     static void gotFinish(bool flag) VL_MT_SAFE;
-    static bool gotFinish() VL_MT_SAFE { return s_s.s_gotFinish; }  ///< Return if got a $finish
+    static bool gotFinish() VL_MT_SAFE {  ///< Return if got a $finish
+        if (VL_UNLIKELY(t_s.t_contextp)) return t_s.t_contextp->gotFinish();
+        return s_s.s_gotFinish; }
     /// Allow traces to at some point be enabled (disables some optimizations)
     static void traceEverOn(bool flag) VL_MT_SAFE {
         if (flag) { calcUnusedSigs(flag); }
     }
     /// Enable/disable assertions
     static void assertOn(bool flag) VL_MT_SAFE;
-    static bool assertOn() VL_MT_SAFE { return s_s.s_assertOn; }
+    static bool assertOn() VL_MT_SAFE {
+        if (VL_UNLIKELY(t_s.t_contextp)) return t_s.t_contextp->assertOn();
+        return s_s.s_assertOn; }
     /// Enable/disable vpi fatal
     static void fatalOnVpiError(bool flag) VL_MT_SAFE;
     static bool fatalOnVpiError() VL_MT_SAFE { return s_s.s_fatalOnVpiError; }
@@ -509,10 +584,16 @@ public:
     // Internal: Throw signal assertion
     static void overWidthError(const char* signame) VL_MT_SAFE;
 
-    // Internal: Find scope
+    // Internal: Find scope, in the thread's context if any
     static const VerilatedScope* scopeFind(const char* namep) VL_MT_SAFE;
     static const VerilatedScopeNameMap* scopeNameMap() VL_MT_SAFE;
 
+    // Internal: Get and set the context of the model being constructed/evaluated
+    // Models use VerilatedContextGuard, so the caller's context is restored on return
+    static VerilatedContext* threadContextp() VL_MT_SAFE { return t_s.t_contextp; }
+    static void threadContextp(VerilatedContext* contextp) VL_MT_SAFE {
+        t_s.t_contextp = contextp; }
+
     // Internal: Get and set DPI context
     static const VerilatedScope* dpiScope() VL_MT_SAFE { return t_s.t_dpiScopep; }
     static void dpiScope(const VerilatedScope* scopep) VL_MT_SAFE { t_s.t_dpiScopep = scopep; }
@@ -554,6 +635,24 @@ private:
 #endif
 };
 
+//===========================================================================
+/// Make a context the thread's current context for the life of the guard,
+/// then restore the previous one.  Used by models when constructing and
+/// evaluating, so Verilated::gotFinish() etc. called from outside a model
+/// see the global state, not the last model's context.
+
+class VerilatedContextGuard {
+    VerilatedContext* m_prevContextp;  ///< Context to restore
+private:
+    VL_UNCOPYABLE(VerilatedContextGuard);
+public:
+    explicit VerilatedContextGuard(VerilatedContext* contextp) VL_MT_SAFE
+        : m_prevContextp(Verilated::threadContextp()) {
+        Verilated::threadContextp(contextp);
+    }
+    ~VerilatedContextGuard() { Verilated::threadContextp(m_prevContextp); }
+};
+
 //=========================================================================
 // Extern functions -- User may override -- See verilated.cpp
 
@@ -646,8 +745,23 @@ inline void VL_WRITEMEM_I(bool hex, int width, int depth, int array_lsb, int fnw
                           IData filename,     const void* memp, IData start, IData end) VL_MT_SAFE {
     VL_WRITEMEM_Q(hex, width, depth, array_lsb, fnwords, filename, memp, start, end); }
 
+/// Pre-parsed element of a $display-like format.  Verilator emits each
+/// constant format as a static table of these, so the format string need
+/// not be re-parsed on every call.  A table ends with an m_fmt of '\0'.
+struct VerilatedFormatOp {
+    const char* m_textp;  ///< Literal text to output before the conversion
+    int m_textlen;  ///< Length of m_textp
+    char m_fmt;  ///< Conversion character, as in a format string, or '\0' if end
+    bool m_widthSet;  ///< Width was specified
+    bool m_zeroPad;  ///< Width had leading zero, so pad with zeros
+    int m_width;  ///< Minimum width
+    const char* m_specp;  ///< Entire conversion as printf format (%e/%f/%g only), else NULL
+};
+
 extern void VL_WRITEF(const char* formatp, ...);
 extern void VL_FWRITEF(IData fpi, const char* formatp, ...);
+extern void VL_WRITEF(const VerilatedFormatOp* opsp, ...);
+extern void VL_FWRITEF(IData fpi, const VerilatedFormatOp* opsp, ...);
 
 extern IData VL_FSCANF_IX(IData fpi, const char* formatp, ...);
 extern IData VL_SSCANF_IIX(int lbits, IData ld, const char* formatp, ...);
@@ -659,6 +773,11 @@ extern void VL_SFORMAT_X(int obits, SData& destr, const char* formatp, ...);
 extern void VL_SFORMAT_X(int obits, IData& destr, const char* formatp, ...);
 extern void VL_SFORMAT_X(int obits, QData& destr, const char* formatp, ...);
 extern void VL_SFORMAT_X(int obits, void* destp, const char* formatp, ...);
+extern void VL_SFORMAT_X(int obits, CData& destr, const VerilatedFormatOp* opsp, ...);
+extern void VL_SFORMAT_X(int obits, SData& destr, const VerilatedFormatOp* opsp, ...);
+extern void VL_SFORMAT_X(int obits, IData& destr, const VerilatedFormatOp* opsp, ...);
+extern void VL_SFORMAT_X(int obits, QData& destr, const VerilatedFormatOp* opsp, ...);
+extern void VL_SFORMAT_X(int obits, void* destp, const VerilatedFormatOp* opsp, ...);
 
 extern IData VL_SYSTEM_IW(int lhswords, WDataInP lhsp);
 extern IData VL_SYSTEM_IQ(QData lhs);
@@ -764,10 +883,25 @@ extern int VL_TIME_STR_CONVERT(const char* strp) VL_PURE;
 # define VL_TIME_Q() (static_cast<QData>(sc_time_stamp().to_default_time_units()*VL_TIME_MULTIPLIER))
 # define VL_TIME_D() (static_cast<double>(sc_time_stamp().to_default_time_units()*VL_TIME_MULTIPLIER))
 #else
-# define VL_TIME_I() (static_cast<IData>(sc_time_stamp()*VL_TIME_MULTIPLIER))
-# define VL_TIME_Q() (static_cast<QData>(sc_time_stamp()*VL_TIME_MULTIPLIER))
-# define VL_TIME_D() (static_cast<double>(sc_time_stamp()*VL_TIME_MULTIPLIER))
+# define VL_TIME_I() (static_cast<IData>(vl_time_stamp()*VL_TIME_MULTIPLIER))
+# define VL_TIME_Q() (static_cast<QData>(vl_time_stamp()*VL_TIME_MULTIPLIER))
+# define VL_TIME_D() (static_cast<double>(vl_time_stamp()*VL_TIME_MULTIPLIER))
+# ifdef VL_ATTR_WEAK
+/// Weak where supported, so programs where every model has a
+/// VerilatedContext need not define sc_time_stamp()
+extern double sc_time_stamp() VL_ATTR_WEAK;
+# else
 extern double sc_time_stamp();
+# endif
+/// Time of the VerilatedContext of the model being evaluated, else sc_time_stamp()
+inline double vl_time_stamp() VL_MT_SAFE {
+    const VerilatedContext* contextp = Verilated::threadContextp();
+    if (VL_UNLIKELY(contextp)) return static_cast<double>(contextp->time());
+# ifdef VL_ATTR_WEAK
+    if (VL_UNLIKELY(!sc_time_stamp)) return 0;  // Not defined by the program
+# endif
+    return sc_time_stamp();
+}
 #endif
 
 /// Evaluate expression if debug enabled
@@ -1186,13 +1320,19 @@ static inline IData VL_MOSTSETBITP1_W(int words, WDataInP lwp) VL_MT_SAFE {
 //===================================================================
 // SIMPLE LOGICAL OPERATORS
 
+// Wide bitwise operations may be called with the output the same as an
+// input, but never with partially overlapping words, so the loops may be
+// vectorized without alias checks.
+
 // EMIT_RULE: VL_AND:  oclean=lclean||rclean; obits=lbits; lbits==rbits;
 static inline WDataOutP VL_AND_W(int words, WDataOutP owp, WDataInP lwp, WDataInP rwp) VL_MT_SAFE {
+    VL_LOOP_IVDEP
     for (int i=0; (i < words); ++i) owp[i] = (lwp[i] & rwp[i]);
     return owp;
 }
 // EMIT_RULE: VL_OR:   oclean=lclean&&rclean; obits=lbits; lbits==rbits;
 static inline WDataOutP VL_OR_W(int words, WDataOutP owp, WDataInP lwp, WDataInP rwp) VL_MT_SAFE {
+    VL_LOOP_IVDEP
     for (int i=0; (i < words); ++i) owp[i] = (lwp[i] | rwp[i]);
     return owp;
 }
@@ -1204,16 +1344,19 @@ static inline IData VL_CHANGEXOR_W(int words, WDataInP lwp, WDataInP rwp) VL_MT_
 }
 // EMIT_RULE: VL_XOR:  oclean=lclean&&rclean; obits=lbits; lbits==rbits;
 static inline WDataOutP VL_XOR_W(int words, WDataOutP owp, WDataInP lwp, WDataInP rwp) VL_MT_SAFE {
+    VL_LOOP_IVDEP
     for (int i=0; (i < words); ++i) owp[i] = (lwp[i] ^ rwp[i]);
     return owp;
 }
 // EMIT_RULE: VL_XNOR:  oclean=dirty; obits=lbits; lbits==rbits;
 static inline WDataOutP VL_XNOR_W(int words, WDataOutP owp, WDataInP lwp, WDataInP rwp) VL_MT_SAFE {
+    VL_LOOP_IVDEP
     for (int i=0; (i < words); ++i) owp[i] = (lwp[i] ^ ~rwp[i]);
     return owp;
 }
 // EMIT_RULE: VL_NOT:  oclean=dirty; obits=lbits;
 static inline WDataOutP VL_NOT_W(int words, WDataOutP owp, WDataInP lwp) VL_MT_SAFE {
+    VL_LOOP_IVDEP
     for (int i=0; i < words; ++i) owp[i] = ~(lwp[i]);
     return owp;
 }
@@ -1344,18 +1487,61 @@ static inline WDataOutP VL_NEGATE_W(int words, WDataOutP owp, WDataInP lwp) VL_M
 #define VL_MODDIV_QQQ(lbits,lhs,rhs)    (((rhs)==0)?0:(lhs)%(rhs))
 #define VL_MODDIV_WWW(lbits,owp,lwp,rwp) (_vl_moddiv_w(lbits,owp,lwp,rwp,1))
 
+// Wide add, subtract and multiply work on pairs of EData as 64-bit quads
+// where the host is little endian and has a 128-bit type for products,
+// halving the number of carry steps and quartering the multiplies.
+#if defined(__GNUC__) && defined(__SIZEOF_INT128__) && defined(__BYTE_ORDER__) \
+    && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) && !defined(VL_NO_BUILTINS)
+# define VL_WIDE_QUADS 1
+__extension__ typedef unsigned __int128 vluint128_t;
+// Quad q of a wide; the upper half of a final odd word reads as zero
+static inline QData _vl_quad_get(int words, WDataInP lwp, int q) VL_MT_SAFE {
+    if (2 * q + 1 >= words) return lwp[2 * q];
+    QData data;
+    memcpy(&data, lwp + 2 * q, sizeof(data));
+    return data;
+}
+static inline void _vl_quad_set(int words, WDataOutP owp, int q, QData data) VL_MT_SAFE {
+    if (2 * q + 1 >= words) { owp[2 * q] = static_cast<EData>(data); return; }
+    memcpy(owp + 2 * q, &data, sizeof(data));
+}
+#endif
+
 static inline WDataOutP VL_ADD_W(int words, WDataOutP owp, WDataInP lwp, WDataInP rwp) VL_MT_SAFE {
+#ifdef VL_WIDE_QUADS
+    QData carry = 0;
+    for (int q = 0; q < (words + 1) / 2; ++q) {
+        QData lhs = _vl_quad_get(words, lwp, q);
+        QData sum = lhs + _vl_quad_get(words, rwp, q);
+        QData lcarry = (sum < lhs);
+        sum += carry;
+        carry = lcarry | (sum < carry);
+        _vl_quad_set(words, owp, q, sum);
+    }
+#else
     QData carry = 0;
     for (int i = 0; i < words; ++i) {
         carry = carry + static_cast<QData>(lwp[i]) + static_cast<QData>(rwp[i]);
         owp[i] = (carry & VL_ULL(0xffffffff));
         carry = (carry >> VL_ULL(32)) & VL_ULL(0xffffffff);
     }
+#endif
     // Last output word is dirty
     return owp;
 }
 
 static inline WDataOutP VL_SUB_W(int words, WDataOutP owp, WDataInP lwp, WDataInP rwp) VL_MT_SAFE {
+#ifdef VL_WIDE_QUADS
+    QData carry = 1;  // Negation of rwp
+    for (int q = 0; q < (words + 1) / 2; ++q) {
+        QData lhs = _vl_quad_get(words, lwp, q);
+        QData sum = lhs + ~_vl_quad_get(words, rwp, q);
+        QData lcarry = (sum < lhs);
+        sum += carry;
+        carry = lcarry | (sum < carry);
+        _vl_quad_set(words, owp, q, sum);
+    }
+#else
     QData carry = 0;
     for (int i = 0; i < words; ++i) {
         carry = (carry + static_cast<QData>(lwp[i])
@@ -1364,12 +1550,27 @@ static inline WDataOutP VL_SUB_W(int words, WDataOutP owp, WDataInP lwp, WDataIn
         owp[i] = (carry & VL_ULL(0xffffffff));
         carry = (carry >> VL_ULL(32)) & VL_ULL(0xffffffff);
     }
+#endif
     // Last output word is dirty
     return owp;
 }
 
 static inline WDataOutP VL_MUL_W(int words, WDataOutP owp, WDataInP lwp, WDataInP rwp) VL_MT_SAFE {
     for (int i=0; i<words; ++i) owp[i] = 0;
+#ifdef VL_WIDE_QUADS
+    int quads = (words + 1) / 2;
+    for (int lquad=0; lquad<quads; ++lquad) {
+        for (int rquad=0; rquad<quads-lquad; ++rquad) {
+            vluint128_t mul = static_cast<vluint128_t>(_vl_quad_get(words, lwp, lquad))
+                * _vl_quad_get(words, rwp, rquad);
+            for (int qquad=lquad+rquad; qquad<quads; ++qquad) {
+                mul += _vl_quad_get(words, owp, qquad);
+                _vl_quad_set(words, owp, qquad, static_cast<QData>(mul));
+                mul >>= VL_QUADSIZE;
+            }
+        }
+    }
+#else
     for (int lword=0; lword<words; ++lword) {
         for (int rword=0; rword<words; ++rword) {
             QData mul = static_cast<QData>(lwp[lword]) * static_cast<QData>(rwp[rword]);
@@ -1380,6 +1581,7 @@ static inline WDataOutP VL_MUL_W(int words, WDataOutP owp, WDataInP lwp, WDataIn
             }
         }
     }
+#endif
     // Last output word is dirty
     return owp;
 }
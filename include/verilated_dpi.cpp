@@ -246,8 +246,10 @@ int svSizeOfArray(const svOpenArrayHandle h) {
 //======================================================================
 // Open array access internals
 
-static void* _vl_sv_adjusted_datap(const VerilatedDpiOpenVar* varp,
-                                   int nargs, int indx1, int indx2, int indx3) {
+static inline void* _vl_sv_adjusted_datap(const VerilatedDpiOpenVar* varp,
+                                          int nargs, int indx1, int indx2, int indx3) {
+    // Strides are precomputed in VerilatedVarProps, so each index is one bounds check
+    // and one multiply-add
     void* datap = varp->datap();
     if (VL_UNLIKELY(nargs != varp->udims())) {
         _VL_SVDPI_WARN("%%Warning: DPI svOpenArrayHandle function called on"
@@ -275,7 +277,7 @@ static void* _vl_sv_adjusted_datap(const VerilatedDpiOpenVar* varp,
         datap = varp->datapAdjustIndex(datap, 3, indx3);
         if (VL_UNLIKELY(!datap)) {
             _VL_SVDPI_WARN("%%Warning: DPI svOpenArrayHandle function index 3 out of bounds; %d outside [%d:%d].\n",
-                           indx1, varp->left(3), varp->right(3));
+                           indx3, varp->left(3), varp->right(3));
             return NULL;
         }
     }
@@ -300,23 +302,20 @@ static void* _vl_svGetArrElemPtr(const svOpenArrayHandle h,
     return datap;
 }
 
-/// Copy to user bit array from simulator open array
-static void _vl_svGetBitArrElemVecVal(svBitVecVal* d, const svOpenArrayHandle s,
-                                      int nargs, int indx1, int indx2, int indx3) VL_MT_SAFE {
-    const VerilatedDpiOpenVar* varp = _vl_openhandle_varp(s);
-    void* datap = _vl_sv_adjusted_datap(varp, nargs, indx1, indx2, indx3);
-    if (VL_UNLIKELY(!datap)) return;
+/// Copy to user bit array from simulator element data
+static void _vl_sv_get_bitvecval(svBitVecVal* d, const VerilatedDpiOpenVar* varp,
+                                 const void* datap) VL_MT_SAFE {
     switch (varp->vltype()) {
-    case VLVT_UINT8:  d[0] = *(reinterpret_cast<CData*>(datap)); return;
-    case VLVT_UINT16: d[0] = *(reinterpret_cast<SData*>(datap)); return;
-    case VLVT_UINT32: d[0] = *(reinterpret_cast<IData*>(datap)); return;
+    case VLVT_UINT8:  d[0] = *(reinterpret_cast<const CData*>(datap)); return;
+    case VLVT_UINT16: d[0] = *(reinterpret_cast<const SData*>(datap)); return;
+    case VLVT_UINT32: d[0] = *(reinterpret_cast<const IData*>(datap)); return;
     case VLVT_UINT64: {
-        WData lwp[2]; VL_SET_WQ(lwp, *(reinterpret_cast<QData*>(datap)));
+        WData lwp[2]; VL_SET_WQ(lwp, *(reinterpret_cast<const QData*>(datap)));
         d[0] = lwp[0]; d[1] = lwp[1];
         break;
     }
     case VLVT_WDATA: {
-        WDataOutP wdatap = (reinterpret_cast<WDataOutP>(datap));
+        WDataInP wdatap = (reinterpret_cast<WDataInP>(datap));
         for (int i=0; i<VL_WORDS_I(varp->packed().elements()); ++i) d[i] = wdatap[i];
         return;
     }
@@ -326,6 +325,14 @@ static void _vl_svGetBitArrElemVecVal(svBitVecVal* d, const svOpenArrayHandle s,
         return;
     }
 }
+/// Copy to user bit array from simulator open array
+static void _vl_svGetBitArrElemVecVal(svBitVecVal* d, const svOpenArrayHandle s,
+                                      int nargs, int indx1, int indx2, int indx3) VL_MT_SAFE {
+    const VerilatedDpiOpenVar* varp = _vl_openhandle_varp(s);
+    void* datap = _vl_sv_adjusted_datap(varp, nargs, indx1, indx2, indx3);
+    if (VL_UNLIKELY(!datap)) return;
+    _vl_sv_get_bitvecval(d, varp, datap);
+}
 /// Copy to user logic array from simulator open array
 static void _vl_svGetLogicArrElemVecVal(svLogicVecVal* d, const svOpenArrayHandle s,
                                         int nargs, int indx1, int indx2, int indx3) VL_MT_SAFE {
@@ -356,12 +363,9 @@ static void _vl_svGetLogicArrElemVecVal(svLogicVecVal* d, const svOpenArrayHandl
     }
 }
 
-/// Copy to simulator open array from from user bit array
-static void _vl_svPutBitArrElemVecVal(const svOpenArrayHandle d, const svBitVecVal* s,
-                                      int nargs, int indx1, int indx2, int indx3) VL_MT_SAFE {
-    const VerilatedDpiOpenVar* varp = _vl_openhandle_varp(d);
-    void* datap = _vl_sv_adjusted_datap(varp, nargs, indx1, indx2, indx3);
-    if (VL_UNLIKELY(!datap)) return;
+/// Copy to simulator element data from user bit array
+static void _vl_sv_put_bitvecval(void* datap, const VerilatedDpiOpenVar* varp,
+                                 const svBitVecVal* s) VL_MT_SAFE {
     switch (varp->vltype()) {
     case VLVT_UINT8:  *(reinterpret_cast<CData*>(datap)) = s[0]; return;
     case VLVT_UINT16: *(reinterpret_cast<SData*>(datap)) = s[0]; return;
@@ -378,6 +382,14 @@ static void _vl_svPutBitArrElemVecVal(const svOpenArrayHandle d, const svBitVecV
         return;
     }
 }
+/// Copy to simulator open array from from user bit array
+static void _vl_svPutBitArrElemVecVal(const svOpenArrayHandle d, const svBitVecVal* s,
+                                      int nargs, int indx1, int indx2, int indx3) VL_MT_SAFE {
+    const VerilatedDpiOpenVar* varp = _vl_openhandle_varp(d);
+    void* datap = _vl_sv_adjusted_datap(varp, nargs, indx1, indx2, indx3);
+    if (VL_UNLIKELY(!datap)) return;
+    _vl_sv_put_bitvecval(datap, varp, s);
+}
 /// Copy to simulator open array from from user logic array
 static void _vl_svPutLogicArrElemVecVal(const svOpenArrayHandle d, const svLogicVecVal* s,
                                         int nargs, int indx1, int indx2, int indx3) VL_MT_SAFE {
@@ -722,6 +734,51 @@ void svPutLogicArrElem3(const svOpenArrayHandle d, svLogic value,
     svPutBitArrElem3(d, value, indx1, indx2, indx3);
 }
 
+//======================================================================
+// Verilator extensions for bulk open array access
+
+/// Return element pointer for the first element of a bulk access, or NULL if bad
+static void* _vl_sv_bulk_datap(const VerilatedDpiOpenVar* varp, int indx1, int count) {
+    if (VL_UNLIKELY(varp->udims() != 1)) {
+        _VL_SVDPI_WARN("%%Warning: DPI bulk svOpenArrayHandle function called on"
+                       " %d dimensional array; only 1 dimensional supported.\n",
+                       varp->udims());
+        return NULL;
+    }
+    if (VL_UNLIKELY(count < 0 || indx1 < varp->low(1)
+                    || (indx1 + count - 1) > varp->high(1))) {
+        _VL_SVDPI_WARN("%%Warning: DPI bulk svOpenArrayHandle function index out of bounds;"
+                       " [%d+:%d] outside [%d:%d].\n",
+                       indx1, count, varp->left(1), varp->right(1));
+        return NULL;
+    }
+    return varp->datapAdjustIndex(varp->datap(), 1, indx1);
+}
+
+void vl_svGetBitArrElemsVecVal(svBitVecVal* d, const svOpenArrayHandle s,
+                               int indx1, int count) VL_MT_SAFE {
+    const VerilatedDpiOpenVar* varp = _vl_openhandle_varp(s);
+    vluint8_t* datap = reinterpret_cast<vluint8_t*>(_vl_sv_bulk_datap(varp, indx1, count));
+    if (VL_UNLIKELY(!datap)) return;
+    const size_t stride = varp->stride(1);
+    const int dwords = VL_WORDS_I(varp->packed().elements());
+    for (int i=0; i<count; ++i, datap += stride, d += dwords) {
+        _vl_sv_get_bitvecval(d, varp, datap);
+    }
+}
+
+void vl_svPutBitArrElemsVecVal(const svOpenArrayHandle d, const svBitVecVal* s,
+                               int indx1, int count) VL_MT_SAFE {
+    const VerilatedDpiOpenVar* varp = _vl_openhandle_varp(d);
+    vluint8_t* datap = reinterpret_cast<vluint8_t*>(_vl_sv_bulk_datap(varp, indx1, count));
+    if (VL_UNLIKELY(!datap)) return;
+    const size_t stride = varp->stride(1);
+    const int swords = VL_WORDS_I(varp->packed().elements());
+    for (int i=0; i<count; ++i, datap += stride, s += swords) {
+        _vl_sv_put_bitvecval(datap, varp, s);
+    }
+}
+
 //======================================================================
 // Functions for working with DPI context
 
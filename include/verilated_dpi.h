@@ -77,6 +77,19 @@ static inline void VL_SET_SVLV_Q(int, svLogicVecVal* owp, QData ld) VL_MT_SAFE {
     owp[1].aval=lwp[1]; owp[1].bval=0;
 }
 
+//===================================================================
+// Verilator extensions for bulk open array access
+
+/// Copy count elements of a one dimensional open array, starting at index
+/// indx1 and moving towards high(1), into consecutive svBitVecVal's.
+/// Each element occupies SV_PACKED_DATA_NELEMS(svSize(s,0)) words in d.
+extern void vl_svGetBitArrElemsVecVal(svBitVecVal* d, const svOpenArrayHandle s,
+                                      int indx1, int count) VL_MT_SAFE;
+/// Copy count consecutive svBitVecVal's into a one dimensional open array,
+/// starting at index indx1; the inverse of vl_svGetBitArrElemsVecVal.
+extern void vl_svPutBitArrElemsVecVal(const svOpenArrayHandle d, const svBitVecVal* s,
+                                      int indx1, int count) VL_MT_SAFE;
+
 //======================================================================
 
 #endif  // Guard
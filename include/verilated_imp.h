@@ -199,8 +199,19 @@ class VerilatedImp {
     int                 m_exportNext VL_GUARDED_BY(m_exportMutex);  ///< Next export funcnum
 
     // File I/O
-    VerilatedMutex      m_fdMutex;  ///< Protect m_fdps, m_fdFree
-    std::vector<FILE*>  m_fdps VL_GUARDED_BY(m_fdMutex);  ///< File descriptors
+    // fdToFp is called on every file operation so reads m_fdTablep without m_fdMutex.
+    // The table is never resized in place; fdNew publishes a larger copy, and keeps
+    // the superseded table as a reader might still be looking at it.  Tables are
+    // never freed, as files may still be written from other static destructors.
+    typedef std::vector<FILE*> FdTable;
+    VerilatedMutex      m_fdMutex;  ///< Protect m_fdFree, m_fdPiped, m_fdOldTables, table writes
+#ifdef VL_THREADED
+    std::atomic<FdTable*> m_fdTablep;  ///< File descriptors (lock free read)
+#else
+    FdTable*            m_fdTablep;  ///< File descriptors
+#endif
+    std::vector<FdTable*> m_fdOldTables VL_GUARDED_BY(m_fdMutex);  ///< Superseded tables
+    std::vector<bool>   m_fdPiped VL_GUARDED_BY(m_fdMutex);  ///< Descriptor needs pclose
     std::deque<IData>   m_fdFree VL_GUARDED_BY(m_fdMutex);  ///< List of free descriptors (SLOW - FOPEN/CLOSE only)
 
 public:  // But only for verilated*.cpp
@@ -208,10 +219,12 @@ public:  // But only for verilated*.cpp
     VerilatedImp()
         : m_argVecLoaded(false)
         , m_exportNext(0) {
-        m_fdps.resize(3);
-        m_fdps[0] = stdin;
-        m_fdps[1] = stdout;
-        m_fdps[2] = stderr;
+        FdTable* tablep = new FdTable(3);
+        (*tablep)[0] = stdin;
+        (*tablep)[1] = stdout;
+        (*tablep)[2] = stderr;
+        m_fdTablep = tablep;
+        m_fdPiped.resize(3);
     }
     ~VerilatedImp() {}
 private:
@@ -226,9 +239,17 @@ public:
     static void commandArgs(int argc, const char** argv) VL_EXCLUDES(s_s.m_argMutex);
     static void commandArgsAdd(int argc, const char** argv) VL_EXCLUDES(s_s.m_argMutex);
     static std::string argPlusMatch(const char* prefixp) VL_EXCLUDES(s_s.m_argMutex) {
-        VerilatedLockGuard lock(s_s.m_argMutex);
         // Note prefixp does not include the leading "+"
         size_t len = strlen(prefixp);
+        const VerilatedContext* contextp = Verilated::threadContextp();
+        if (contextp && contextp->argc()) {
+            for (int i = 0; i < contextp->argc(); ++i) {
+                const char* argp = contextp->argv()[i];
+                if (argp[0] == '+' && 0 == strncmp(prefixp, argp + 1, len)) return argp;
+            }
+            return "";
+        }
+        VerilatedLockGuard lock(s_s.m_argMutex);
         if (VL_UNLIKELY(!s_s.m_argVecLoaded)) {
             s_s.m_argVecLoaded = true;  // Complain only once
             VL_FATAL_MT("unknown", 0, "",
@@ -293,6 +314,12 @@ public:  // But only for verilated*.cpp
     // METHODS - scope name
     static void scopeInsert(const VerilatedScope* scopep) VL_MT_SAFE {
         // Slow ok - called once/scope at construction
+        // Models with a context keep their scopes separate from any other
+        // model of the same name
+        if (VerilatedContext* contextp = scopeContextp(scopep)) {
+            contextp->scopeInsert(scopep);
+            return;
+        }
         VerilatedLockGuard lock(s_s.m_nameMutex);
         VerilatedScopeNameMap::iterator it = s_s.m_nameMap.find(scopep->name());
         if (it == s_s.m_nameMap.end()) {
@@ -300,6 +327,9 @@ public:  // But only for verilated*.cpp
         }
     }
     static inline const VerilatedScope* scopeFind(const char* namep) VL_MT_SAFE {
+        if (VerilatedContext* contextp = Verilated::threadContextp()) {
+            return contextp->scopeFind(namep);
+        }
         VerilatedLockGuard lock(s_s.m_nameMutex);
         // If too slow, can assume this is only VL_MT_SAFE_POSINIT
         VerilatedScopeNameMap::const_iterator it=s_s.m_nameMap.find(namep);
@@ -308,14 +338,24 @@ public:  // But only for verilated*.cpp
     }
     static void scopeErase(const VerilatedScope* scopep) VL_MT_SAFE {
         // Slow ok - called once/scope at destruction
-        VerilatedLockGuard lock(s_s.m_nameMutex);
         userEraseScope(scopep);
+        if (VerilatedContext* contextp = scopeContextp(scopep)) {
+            contextp->scopeErase(scopep);
+            return;
+        }
+        VerilatedLockGuard lock(s_s.m_nameMutex);
+        // Another model of the same name may have inserted the scope
         VerilatedScopeNameMap::iterator it = s_s.m_nameMap.find(scopep->name());
-        if (it != s_s.m_nameMap.end()) s_s.m_nameMap.erase(it);
+        if (it != s_s.m_nameMap.end() && it->second == scopep) s_s.m_nameMap.erase(it);
     }
     static void scopesDump() VL_MT_SAFE {
-        VerilatedLockGuard lock(s_s.m_nameMutex);
         VL_PRINTF_MT("  scopesDump:\n");
+        if (VerilatedContext* contextp = Verilated::threadContextp()) {
+            contextp->scopesDump();
+            VL_PRINTF_MT("\n");
+            return;
+        }
+        VerilatedLockGuard lock(s_s.m_nameMutex);
         for (VerilatedScopeNameMap::const_iterator it = s_s.m_nameMap.begin();
              it != s_s.m_nameMap.end(); ++it) {
             const VerilatedScope* scopep = it->second;
@@ -325,8 +365,15 @@ public:  // But only for verilated*.cpp
     }
     static const VerilatedScopeNameMap* scopeNameMap() VL_MT_SAFE_POSTINIT {
         // Thread save only assuming this is called only after model construction completed
+        if (VerilatedContext* contextp = Verilated::threadContextp()) {
+            return contextp->scopeNameMap();
+        }
         return &s_s.m_nameMap;
     }
+private:
+    static VerilatedContext* scopeContextp(const VerilatedScope* scopep) VL_MT_SAFE {
+        return scopep->symsp() ? scopep->symsp()->__Vm_contextp : NULL;
+    }
 
 public:  // But only for verilated*.cpp
     // METHODS - hierarchy
@@ -392,33 +439,44 @@ public:  // But only for verilated*.cpp
 
 public:  // But only for verilated*.cpp
     // METHODS - file IO
-    static IData fdNew(FILE* fp) VL_MT_SAFE {
+    static IData fdNew(FILE* fp, bool piped = false) VL_MT_SAFE {
         if (VL_UNLIKELY(!fp)) return 0;
         // Bit 31 indicates it's a descriptor not a MCD
         VerilatedLockGuard lock(s_s.m_fdMutex);
+        FdTable* tablep = s_s.m_fdTablep;
         if (s_s.m_fdFree.empty()) {
-            // Need to create more space in m_fdps and m_fdFree
-            size_t start = s_s.m_fdps.size();
-            s_s.m_fdps.resize(start*2);
+            // Need to create more space in the table and m_fdFree
+            size_t start = tablep->size();
+            FdTable* newp = new FdTable(*tablep);
+            newp->resize(start*2);
+            s_s.m_fdOldTables.push_back(tablep);
+            s_s.m_fdTablep = tablep = newp;
+            s_s.m_fdPiped.resize(start*2);
             for (size_t i=start; i<start*2; ++i) s_s.m_fdFree.push_back(static_cast<IData>(i));
         }
         IData idx = s_s.m_fdFree.back(); s_s.m_fdFree.pop_back();
-        s_s.m_fdps[idx] = fp;
+        (*tablep)[idx] = fp;
+        s_s.m_fdPiped[idx] = piped;
         return (idx | (1UL<<31));  // bit 31 indicates not MCD
     }
-    static void fdDelete(IData fdi) VL_MT_SAFE {
+    /// Remove descriptor from the table, returning if it was opened with popen
+    static bool fdDelete(IData fdi) VL_MT_SAFE {
         IData idx = VL_MASK_I(31) & fdi;
         VerilatedLockGuard lock(s_s.m_fdMutex);
-        if (VL_UNLIKELY(!(fdi & (VL_ULL(1) << 31)) || idx >= s_s.m_fdps.size())) return;
-        if (VL_UNLIKELY(!s_s.m_fdps[idx])) return;  // Already free
-        s_s.m_fdps[idx] = NULL;
+        FdTable* tablep = s_s.m_fdTablep;
+        if (VL_UNLIKELY(!(fdi & (VL_ULL(1) << 31)) || idx >= tablep->size())) return false;
+        if (VL_UNLIKELY(!(*tablep)[idx])) return false;  // Already free
+        (*tablep)[idx] = NULL;
         s_s.m_fdFree.push_back(idx);
+        return s_s.m_fdPiped[idx];
     }
     static inline FILE* fdToFp(IData fdi) VL_MT_SAFE {
         IData idx = VL_MASK_I(31) & fdi;
-        VerilatedLockGuard lock(s_s.m_fdMutex);  // This might get slow, if it does we can cache it
-        if (VL_UNLIKELY(!(fdi & (VL_ULL(1) << 31)) || idx >= s_s.m_fdps.size())) return NULL;
-        return s_s.m_fdps[idx];
+        // No lock; as with the stdio calls on the result, each thread can only access
+        // different file handles, so the slot itself doesn't race with fdNew/fdDelete
+        const FdTable* tablep = s_s.m_fdTablep;
+        if (VL_UNLIKELY(!(fdi & (VL_ULL(1) << 31)) || idx >= tablep->size())) return NULL;
+        return (*tablep)[idx];
     }
 };
 
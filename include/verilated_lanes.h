@@ -0,0 +1,107 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//=============================================================================
+//
+// THIS MODULE IS PUBLICLY LICENSED
+//
+// Copyright 2020 by Wilson Snyder.  This program is free software;
+// you can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License Version 2.0.
+//
+// This is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+//=============================================================================
+///
+/// \file
+/// \brief Lockstep evaluation of independent model lanes
+///
+//=============================================================================
+
+#ifndef _VERILATED_LANES_H_
+#define _VERILATED_LANES_H_ 1
+
+#include "verilatedos.h"
+#include "verilated.h"
+
+#include <vector>
+
+//=============================================================================
+/// Several independent simulations of one model, each with its own
+/// VerilatedContext, stepped together on the calling thread.
+/// Lane i is seeded with firstSeed+i and sees the same plusargs as the
+/// other lanes.  Every lane has the same name, so %m and scope names are
+/// the same in every lane; each context has its own scope table.  Running
+/// many short seeds as lanes of one process avoids per-process startup,
+/// and keeps the model's code hot in the cache.  The lanes are evaluated
+/// one after another; the model's code is not vectorized across lanes.
+///
+///     VerilatedLanes<Vtop> lanes(8, seed, argc, argv);
+///     while (!lanes.gotFinish()) {
+///         for (int i = 0; i < lanes.lanes(); ++i) lanes.modelp(i)->clk = ...;
+///         lanes.eval();
+///         lanes.timeInc(1);
+///     }
+///     lanes.final();
+
+template <class T_Model> class VerilatedLanes {
+    // TYPES
+    typedef std::vector<VerilatedContext*> Contexts;
+    typedef std::vector<T_Model*> Models;
+    // MEMBERS
+    Contexts m_contexts;  ///< Context of each lane
+    Models m_models;  ///< Model of each lane
+private:
+    VL_UNCOPYABLE(VerilatedLanes);
+public:
+    // CONSTRUCTORS
+    /// Create lanes; argv must remain valid for the life of the lanes
+    VerilatedLanes(int lanes, int firstSeed, int argc, const char** argv,
+                   const char* namep = "TOP") {
+        m_contexts.reserve(lanes);
+        m_models.reserve(lanes);
+        for (int i = 0; i < lanes; ++i) {
+            VerilatedContext* contextp = new VerilatedContext;
+            contextp->randSeed(firstSeed + i);
+            contextp->commandArgs(argc, argv);
+            m_contexts.push_back(contextp);
+            m_models.push_back(new T_Model(contextp, namep));
+        }
+    }
+    ~VerilatedLanes() {
+        for (size_t i = 0; i < m_models.size(); ++i) {
+            delete m_models[i];
+            delete m_contexts[i];
+        }
+    }
+    // METHODS
+    int lanes() const { return static_cast<int>(m_models.size()); }
+    T_Model* modelp(int lane) const { return m_models[lane]; }
+    VerilatedContext* contextp(int lane) const { return m_contexts[lane]; }
+    /// Evaluate every lane that has not yet executed $finish
+    void eval() {
+        for (size_t i = 0; i < m_models.size(); ++i) {
+            if (!m_contexts[i]->gotFinish()) m_models[i]->eval();
+        }
+    }
+    /// Advance time of every lane that has not yet executed $finish
+    void timeInc(vluint64_t add) {
+        for (size_t i = 0; i < m_contexts.size(); ++i) {
+            if (!m_contexts[i]->gotFinish()) m_contexts[i]->timeInc(add);
+        }
+    }
+    /// True when every lane has executed $finish
+    bool gotFinish() const {
+        for (size_t i = 0; i < m_contexts.size(); ++i) {
+            if (!m_contexts[i]->gotFinish()) return false;
+        }
+        return true;
+    }
+    /// Run final blocks of every lane
+    void final() {
+        for (size_t i = 0; i < m_models.size(); ++i) m_models[i]->final();
+    }
+};
+
+#endif  // Guard
@@ -73,57 +73,64 @@ class VerilatedVarProps {
     const int                   m_udims;        // Unpacked dimensions
     VerilatedRange              m_packed;       // Packed array range
     VerilatedRange              m_unpacked[3];  // Unpacked array range
+    size_t                      m_strides[3];   // Bytes between elements of each unpacked dim
     // CONSTRUCTORS
 protected:
     friend class VerilatedScope;
     VerilatedVarProps(VerilatedVarType vltype, VerilatedVarFlags vlflags,
                       int pdims, int udims)
-        : m_magic(MAGIC), m_vltype(vltype), m_vlflags(vlflags), m_pdims(pdims), m_udims(udims) {}
+        : m_magic(MAGIC), m_vltype(vltype), m_vlflags(vlflags), m_pdims(pdims), m_udims(udims) {
+        initStrides(); }
+    /// Recompute m_strides; must be called after any range is changed
+    void initStrides();
 public:
     class Unpacked {};
     // Without packed
     VerilatedVarProps(VerilatedVarType vltype, int vlflags)
         : m_magic(MAGIC), m_vltype(vltype),
-          m_vlflags(VerilatedVarFlags(vlflags)), m_pdims(0), m_udims(0) { }
+          m_vlflags(VerilatedVarFlags(vlflags)), m_pdims(0), m_udims(0) { initStrides(); }
     VerilatedVarProps(VerilatedVarType vltype, int vlflags,
                       Unpacked, int u0l, int u0r)
         : m_magic(MAGIC), m_vltype(vltype),
           m_vlflags(VerilatedVarFlags(vlflags)), m_pdims(0), m_udims(1) {
-        m_unpacked[0].init(u0l, u0r); }
+        m_unpacked[0].init(u0l, u0r); initStrides(); }
     VerilatedVarProps(VerilatedVarType vltype, int vlflags,
                       Unpacked, int u0l, int u0r, int u1l, int u1r)
         : m_magic(MAGIC), m_vltype(vltype),
           m_vlflags(VerilatedVarFlags(vlflags)), m_pdims(0), m_udims(2) {
-        m_unpacked[0].init(u0l, u0r); m_unpacked[1].init(u1l, u1r); }
+        m_unpacked[0].init(u0l, u0r); m_unpacked[1].init(u1l, u1r); initStrides(); }
     VerilatedVarProps(VerilatedVarType vltype, int vlflags,
                       Unpacked, int u0l, int u0r, int u1l, int u1r, int u2l, int u2r)
         : m_magic(MAGIC), m_vltype(vltype),
           m_vlflags(VerilatedVarFlags(vlflags)), m_pdims(0), m_udims(3) {
-        m_unpacked[0].init(u0l, u0r); m_unpacked[1].init(u1l, u1r); m_unpacked[2].init(u2l, u2r); }
+        m_unpacked[0].init(u0l, u0r); m_unpacked[1].init(u1l, u1r); m_unpacked[2].init(u2l, u2r);
+        initStrides(); }
     // With packed
     class Packed {};
     VerilatedVarProps(VerilatedVarType vltype, int vlflags,
                       Packed, int pl, int pr)
         : m_magic(MAGIC), m_vltype(vltype),
-          m_vlflags(VerilatedVarFlags(vlflags)), m_pdims(1), m_udims(0), m_packed(pl,pr) { }
+          m_vlflags(VerilatedVarFlags(vlflags)), m_pdims(1), m_udims(0), m_packed(pl,pr) {
+        initStrides(); }
     VerilatedVarProps(VerilatedVarType vltype, int vlflags,
                       Packed, int pl, int pr,
                       Unpacked, int u0l, int u0r)
         : m_magic(MAGIC), m_vltype(vltype),
           m_vlflags(VerilatedVarFlags(vlflags)), m_pdims(1), m_udims(1), m_packed(pl,pr) {
-        m_unpacked[0].init(u0l, u0r); }
+        m_unpacked[0].init(u0l, u0r); initStrides(); }
     VerilatedVarProps(VerilatedVarType vltype, int vlflags,
                       Packed, int pl, int pr,
                       Unpacked, int u0l, int u0r, int u1l, int u1r)
         : m_magic(MAGIC), m_vltype(vltype), m_vlflags(VerilatedVarFlags(vlflags)),
           m_pdims(1), m_udims(2), m_packed(pl,pr) {
-        m_unpacked[0].init(u0l, u0r); m_unpacked[1].init(u1l, u1r); }
+        m_unpacked[0].init(u0l, u0r); m_unpacked[1].init(u1l, u1r); initStrides(); }
     VerilatedVarProps(VerilatedVarType vltype, int vlflags,
                       Packed, int pl, int pr,
                       Unpacked, int u0l, int u0r, int u1l, int u1r, int u2l, int u2r)
         : m_magic(MAGIC), m_vltype(vltype),
           m_vlflags(VerilatedVarFlags(vlflags)), m_pdims(1), m_udims(3), m_packed(pl,pr) {
-        m_unpacked[0].init(u0l, u0r); m_unpacked[1].init(u1l, u1r); m_unpacked[2].init(u2l, u2r); }
+        m_unpacked[0].init(u0l, u0r); m_unpacked[1].init(u1l, u1r); m_unpacked[2].init(u2l, u2r);
+        initStrides(); }
 public:
     ~VerilatedVarProps() {}
     // METHODS
@@ -164,10 +171,19 @@ public:
         return dim==0 ? m_packed.elements()
             : VL_LIKELY(dim>=1 && dim<=3) ? m_unpacked[dim-1].elements() : 0;
     }
+    /// Bytes between consecutive indices of given unpacked dimension, 0 if none
+    size_t stride(int dim) const {
+        return VL_LIKELY(dim>=1 && dim<=m_udims) ? m_strides[dim-1] : 0;
+    }
     /// Total size in bytes (note DPI limited to 4GB)
     size_t totalSize() const;
     /// Adjust a data pointer to access a given array element, NuLL if something goes bad
-    void* datapAdjustIndex(void* datap, int dim, int indx) const;
+    void* datapAdjustIndex(void* datap, int dim, int indx) const {
+        if (VL_UNLIKELY(dim <= 0 || dim > m_udims)) return NULL;
+        const VerilatedRange& range = m_unpacked[dim-1];
+        if (VL_UNLIKELY(indx < range.low() || indx > range.high())) return NULL;
+        return reinterpret_cast<vluint8_t*>(datap) + (indx - range.low()) * m_strides[dim-1];
+    }
 };
 
 //===========================================================================
@@ -202,6 +218,7 @@ public:
     int increment(int dim) const { return m_propsp->increment(dim); }
     int elements(int dim) const { return m_propsp->elements(dim); }
     size_t totalSize() const { return m_propsp->totalSize(); }
+    size_t stride(int dim) const { return m_propsp->stride(dim); }
     void* datapAdjustIndex(void* datap, int dim, int indx) const {
         return m_propsp->datapAdjustIndex(datap, dim, indx); }
 };
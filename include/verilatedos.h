@@ -42,6 +42,9 @@
 # define VL_ATTR_PRINTF(fmtArgNum) __attribute__ ((format (printf, (fmtArgNum), (fmtArgNum)+1)))
 # define VL_ATTR_PURE __attribute__ ((pure))
 # define VL_ATTR_UNUSED __attribute__ ((unused))
+# if !defined(_WIN32) && !defined(__CYGWIN__)
+#  define VL_ATTR_WEAK __attribute__ ((weak))
+# endif
 # define VL_FUNC  __func__
 # if defined(__clang__) && defined(VL_THREADED)
 #  define VL_ACQUIRE(...) __attribute__ ((acquire_capability(__VA_ARGS__)))
@@ -61,6 +64,11 @@
 # define VL_UNREACHABLE __builtin_unreachable();
 # define VL_PREFETCH_RD(p) __builtin_prefetch((p),0)
 # define VL_PREFETCH_RW(p) __builtin_prefetch((p),1)
+# if defined(__clang__)
+#  define VL_LOOP_IVDEP _Pragma("clang loop vectorize(assume_safety)")
+# elif (__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)
+#  define VL_LOOP_IVDEP _Pragma("GCC ivdep")
+# endif
 #elif defined(_MSC_VER)
 # define VL_FUNC  __FUNCTION__
 #endif
@@ -120,6 +128,9 @@
 #ifndef VL_PREFETCH_RW
 # define VL_PREFETCH_RW(p)              ///< Prefetch data with read/write intent
 #endif
+#ifndef VL_LOOP_IVDEP
+# define VL_LOOP_IVDEP                  ///< Following loop has no dependencies between iterations
+#endif
 
 #ifdef VL_THREADED
 # if defined(_MSC_VER) && _MSC_VER >= 1900
@@ -346,6 +357,10 @@ typedef unsigned long long      vluint64_t;     ///< 64-bit unsigned type
 #define VL_MULS_MAX_WORDS 16            ///< Max size in words of MULS operation
 #define VL_TO_STRING_MAX_WORDS 64       ///< Max size in words of String conversion operation
 
+#ifndef VL_FOPEN_BUFFER_SIZE
+# define VL_FOPEN_BUFFER_SIZE (64*1024)  ///< Bytes of stdio buffer on each file $fopen'ed for write
+#endif
+
 //=========================================================================
 // Base macros
 
@@ -27,9 +27,11 @@
 #include "V3Broken.h"
 #include "V3String.h"
 
+#include <algorithm>
 #include <cstdarg>
 #include <iomanip>
 #include <memory>
+#include <vector>
 
 //======================================================================
 // Statics
@@ -755,6 +757,153 @@ void AstNode::operator delete(void* objp, size_t size) {
     V3Broken::deleted(nodep);
     ::operator delete(objp);
 }
+
+size_t AstNode::releaseFreeSlabs() { return 0; }  // Leak checks use the system allocator
+#else
+// Nodes are carved out of large slabs, and freed nodes are kept on a free
+// list per size class for reuse by the next node of that size.  This avoids
+// the general allocator's per-object header and locking, which dominated
+// allocation time and a good fraction of peak memory on large designs.
+// Slabs whose nodes have all been freed are returned by releaseFree().
+// This is POD so it is usable before static constructors run, and never
+// destructed.
+class AstNodeSlab {
+public:
+    enum MiscConsts {
+        ALIGN = 8,  // Must be >= alignof any AstNode member
+        MAX_SIZE = 512,  // Larger nodes use the system allocator
+        SLAB_SIZE = 1024 * 1024
+    };
+private:
+    struct FreeNode { FreeNode* m_nextp; };
+    struct Slab {
+        char* m_basep;  // Start of slab
+        size_t m_used;  // Bytes carved into nodes
+        size_t m_free;  // Bytes on free lists, valid only in releaseFree()
+        bool operator<(const Slab& rhs) const { return m_basep < rhs.m_basep; }
+    };
+    typedef std::vector<Slab> SlabVec;
+    FreeNode* m_freeps[MAX_SIZE / ALIGN + 1];  // Free list per size class
+    char* m_slabp;  // Unallocated portion of current slab
+    size_t m_slabLeft;  // Bytes remaining in m_slabp
+    SlabVec* m_slabsp;  // All slabs; current slab is last except in releaseFree()
+
+    static size_t sizeClass(size_t size) { return (size + ALIGN - 1) / ALIGN; }
+    void newSlab() {
+        if (!m_slabsp) m_slabsp = new SlabVec;
+        // Any tail of the old slab is abandoned; it's less than MAX_SIZE
+        if (m_slabp) m_slabsp->back().m_used = SLAB_SIZE - m_slabLeft;
+        m_slabp = static_cast<char*>(::operator new(SLAB_SIZE));
+        m_slabLeft = SLAB_SIZE;
+        Slab slab;
+        slab.m_basep = m_slabp;
+        slab.m_used = 0;
+        slab.m_free = 0;
+        m_slabsp->push_back(slab);
+    }
+    Slab* findSlab(void* objp) {
+        // m_slabsp must be sorted
+        Slab key;
+        key.m_basep = static_cast<char*>(objp);
+        SlabVec::iterator it = std::upper_bound(m_slabsp->begin(), m_slabsp->end(), key);
+        if (it == m_slabsp->begin()) return NULL;
+        --it;
+        if (key.m_basep >= it->m_basep + SLAB_SIZE) return NULL;
+        return &*it;
+    }
+    static bool slabEmpty(const Slab* slabp) {
+        return slabp && slabp->m_free == slabp->m_used;
+    }
+public:
+    void* alloc(size_t size) {
+        if (VL_UNLIKELY(size > MAX_SIZE)) return ::operator new(size);
+        size_t cls = sizeClass(size);
+        if (FreeNode* nodep = m_freeps[cls]) {
+            m_freeps[cls] = nodep->m_nextp;
+            return nodep;
+        }
+        size_t bytes = cls * ALIGN;
+        if (VL_UNLIKELY(m_slabLeft < bytes)) newSlab();
+        void* objp = m_slabp;
+        m_slabp += bytes;
+        m_slabLeft -= bytes;
+        return objp;
+    }
+    void free(void* objp, size_t size) {
+        if (VL_UNLIKELY(size > MAX_SIZE)) { ::operator delete(objp); return; }
+        FreeNode* nodep = static_cast<FreeNode*>(objp);
+        size_t cls = sizeClass(size);
+        nodep->m_nextp = m_freeps[cls];
+        m_freeps[cls] = nodep;
+    }
+    size_t releaseFree() {
+        // Return slabs where every node carved so far is on a free list,
+        // typically left behind by a pass that expanded and then discarded
+        // much of the tree.  Returns bytes released.
+        if (!m_slabsp) return 0;
+        char* curBasep = NULL;
+        if (m_slabp) {
+            curBasep = m_slabp - (SLAB_SIZE - m_slabLeft);
+            m_slabsp->back().m_used = SLAB_SIZE - m_slabLeft;
+        }
+        std::sort(m_slabsp->begin(), m_slabsp->end());
+        for (SlabVec::iterator it = m_slabsp->begin(); it != m_slabsp->end(); ++it) {
+            it->m_free = 0;
+        }
+        for (size_t cls = 0; cls <= MAX_SIZE / ALIGN; ++cls) {
+            for (FreeNode* nodep = m_freeps[cls]; nodep; nodep = nodep->m_nextp) {
+                if (Slab* slabp = findSlab(nodep)) slabp->m_free += cls * ALIGN;
+            }
+        }
+        // Unlink the free nodes that live in empty slabs
+        for (size_t cls = 0; cls <= MAX_SIZE / ALIGN; ++cls) {
+            FreeNode** prevpp = &m_freeps[cls];
+            while (FreeNode* nodep = *prevpp) {
+                if (slabEmpty(findSlab(nodep))) {
+                    *prevpp = nodep->m_nextp;
+                } else {
+                    prevpp = &nodep->m_nextp;
+                }
+            }
+        }
+        size_t released = 0;
+        Slab cur;
+        cur.m_basep = NULL;
+        SlabVec kept;
+        for (SlabVec::iterator it = m_slabsp->begin(); it != m_slabsp->end(); ++it) {
+            if (slabEmpty(&*it)) {
+                ::operator delete(it->m_basep);
+                released += SLAB_SIZE;
+            } else if (it->m_basep == curBasep) {
+                cur = *it;
+            } else {
+                kept.push_back(*it);
+            }
+        }
+        if (cur.m_basep) {
+            kept.push_back(cur);  // Keep current slab last
+        } else {
+            m_slabp = NULL;  // Current slab was released, or there was none
+            m_slabLeft = 0;
+        }
+        m_slabsp->swap(kept);
+        return released;
+    }
+};
+static AstNodeSlab s_astNodeSlab;  // Zero initialized
+
+void* AstNode::operator new(size_t size) {
+    return s_astNodeSlab.alloc(size);
+}
+
+void AstNode::operator delete(void* objp, size_t size) {
+    if (!objp) return;
+    s_astNodeSlab.free(objp, size);
+}
+
+size_t AstNode::releaseFreeSlabs() {
+    return s_astNodeSlab.releaseFree();
+}
 #endif
 
 //======================================================================
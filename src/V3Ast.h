@@ -1257,10 +1257,10 @@ public:
 
     // CONSTRUCTORS
     virtual ~AstNode() {}
-#ifdef VL_LEAK_CHECKS
     static void* operator new(size_t size);
     static void operator delete(void* obj, size_t size);
-#endif
+    /// Return memory of node slabs with no live nodes, returns bytes released
+    static size_t releaseFreeSlabs();
 
     // CONSTANT ACCESSORS
     static int instrCountBranch() { return 4; }        ///< Instruction cycles to branch
@@ -2220,6 +2220,7 @@ private:
     bool        m_internal:1;   // Internally created
     bool        m_recursive:1;  // Recursive module
     bool        m_recursiveClone:1;  // If recursive, what module it clones, otherwise NULL
+    bool        m_instTable:1;  // Symbol table needs array of pointers to each instance
     int         m_level;        // 1=top module, 2=cell off top module, ...
     int         m_varNum;       // Incrementing variable number
     int         m_typeNum;      // Incrementing implicit type number
@@ -2229,6 +2230,7 @@ public:
         , m_name(name), m_origName(name)
         , m_modPublic(false), m_modTrace(false), m_inLibrary(false), m_dead(false)
         , m_internal(false), m_recursive(false), m_recursiveClone(false)
+        , m_instTable(false)
         , m_level(0), m_varNum(0), m_typeNum(0) { }
     ASTNODE_BASE_FUNCS(NodeModule)
     virtual void dump(std::ostream& str) const;
@@ -2264,6 +2266,9 @@ public:
     bool recursive() const { return m_recursive; }
     void recursiveClone(bool flag) { m_recursiveClone = flag; }
     bool recursiveClone() const { return m_recursiveClone; }
+    void instTable(bool flag) { m_instTable = flag; }
+    bool instTable() const { return m_instTable; }
+    string instTableName() const { return "__Vinst__"+name(); }
 };
 
 class AstNodeRange : public AstNode {
@@ -805,8 +805,32 @@ AstBasicDType* AstTypeTable::findBasicDType(FileLine* fl, AstBasicDTypeKwd kwd)
     return newp;
 }
 
+AstBasicDType* AstTypeTable::findDetailedDType(AstBasicDTypeKwd kwd, AstNumeric numeric,
+                                               const VNumRange& nrange,
+                                               int width, int widthMin) const {
+    // Look up the type AstBasicDType's constructor would create, without
+    // having to construct one.  V3Width asks for the same few sizes many
+    // times per expression, so the new/deleteTree on every hit was costly.
+    // Must mirror AstBasicDType::init(); returns NULL if that isn't simple.
+    if (kwd == AstBasicDTypeKwd::LOGIC_IMPLICIT) return NULL;
+    if (!width && widthMin < 0) return NULL;  // Sized from keyword
+    if (numeric == AstNumeric::NOSIGN) {
+        if (kwd.isSigned()) numeric = AstNumeric::SIGNED;
+        else if (kwd.isUnsigned()) numeric = AstNumeric::UNSIGNED;
+    }
+    VBasicTypeKey key (width, (widthMin >= 0 ? widthMin : width), numeric, kwd, nrange);
+    DetailedMap::const_iterator it = m_detailedMap.find(key);
+    if (it != m_detailedMap.end()) return it->second;
+    return NULL;
+}
+
 AstBasicDType* AstTypeTable::findLogicBitDType(FileLine* fl, AstBasicDTypeKwd kwd,
                                                int width, int widthMin, AstNumeric numeric) {
+    VNumRange nrange;
+    if (width > 1) nrange.init(width-1, 0, false);
+    if (AstBasicDType* foundp = findDetailedDType(kwd, numeric, nrange, width, widthMin)) {
+        return foundp;
+    }
     AstBasicDType* new1p = new AstBasicDType(fl, kwd, numeric, width, widthMin);
     AstBasicDType* newp = findInsertSameDType(new1p);
     if (newp != new1p) new1p->deleteTree();
@@ -816,6 +840,10 @@ AstBasicDType* AstTypeTable::findLogicBitDType(FileLine* fl, AstBasicDTypeKwd kw
 
 AstBasicDType* AstTypeTable::findLogicBitDType(FileLine* fl, AstBasicDTypeKwd kwd,
                                                VNumRange range, int widthMin, AstNumeric numeric) {
+    if (AstBasicDType* foundp = findDetailedDType(kwd, numeric, range,
+                                                  range.elements(), widthMin)) {
+        return foundp;
+    }
     AstBasicDType* new1p = new AstBasicDType(fl, kwd, numeric, range, widthMin);
     AstBasicDType* newp = findInsertSameDType(new1p);
     if (newp != new1p) new1p->deleteTree();
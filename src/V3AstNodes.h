@@ -6826,6 +6826,8 @@ class AstTypeTable : public AstNode {
     //
     typedef std::map<VBasicTypeKey,AstBasicDType*> DetailedMap;
     DetailedMap m_detailedMap;
+    AstBasicDType* findDetailedDType(AstBasicDTypeKwd kwd, AstNumeric numeric,
+                                     const VNumRange& nrange, int width, int widthMin) const;
 public:
     explicit AstTypeTable(FileLine* fl) : AstNode(fl), m_voidp(NULL) {
         for (int i=0; i<AstBasicDTypeKwd::_ENUM_MAX; ++i) m_basicps[i] = NULL;
@@ -28,9 +28,9 @@
 //                                                  (other items))
 //                                              body
 //              Or, converts to a if/else tree.
-//      FUTURES:
 //          Large 16+ bit tables with constants and no masking (address muxes)
-//              Enter all into std::multimap, sort by value and use a tree of < and == compares.
+//              Sort by value and use a tree of < compares, with == compares at the leaves.
+//      FUTURES:
 //          "Diagonal" find of {rightmost,leftmost} bit {set,clear}
 //              Ignoring mask, check each value is unique (using std::multimap as above?)
 //              Each branch is then mask-and-compare operation (IE
@@ -44,14 +44,20 @@
 #include "V3Global.h"
 #include "V3Case.h"
 #include "V3Ast.h"
+#include "V3InstrCount.h"
 #include "V3Stats.h"
 
 #include <algorithm>
 #include <cstdarg>
+#include <map>
+#include <vector>
 
 #define CASE_OVERLAP_WIDTH 16           // Maximum width we can check for overlaps in
 #define CASE_BARF          999999       // Magic width when non-constant
 #define CASE_ENCODER_GROUP_DEPTH 8      // Levels of priority to be ORed together in top IF tree
+#define CASE_SEARCH_MIN_ITEMS 8         // Minimum values to use binary search tree
+#define CASE_SEARCH_LEAF_ITEMS 4        // Values to compare in order at each search tree leaf
+#define CASE_SEARCH_CLONE_INSTRS 30     // Maximum cost of a body duplicated into several leaves
 
 //######################################################################
 
@@ -128,8 +134,20 @@ private:
     //  AstIf::user3()          -> bool.  Set true to indicate clone not needed
     AstUser3InUse       m_inuser3;
 
+    // TYPES
+    struct SearchValue {
+        vluint64_t      m_value;        // Constant value
+        AstConst*       m_constp;       // Constant node with this value
+        AstCaseItem*    m_itemp;        // Item it selects
+        SearchValue(vluint64_t value, AstConst* constp, AstCaseItem* itemp)
+            : m_value(value), m_constp(constp), m_itemp(itemp) {}
+        bool operator<(const SearchValue& rhs) const { return m_value < rhs.m_value; }
+    };
+    typedef std::vector<SearchValue> SearchValues;
+
     // STATE
     VDouble0 m_statCaseFast;  // Statistic tracking
+    VDouble0 m_statCaseSearch;  // Statistic tracking
     VDouble0 m_statCaseSlow;  // Statistic tracking
 
     // Per-CASE
@@ -137,6 +155,8 @@ private:
     int         m_caseItems;    // Number of caseItem unique values
     bool        m_caseNoOverlapsAllCovered;     // Proven to be synopsys parallel_case compliant
     AstNode*    m_valueItem[1<<CASE_OVERLAP_WIDTH];  // For each possible value, the case branch we need
+    SearchValues m_searchValues;  // Sorted values for binary search
+    AstCaseItem* m_searchDefaultp;  // Default item for binary search, or NULL
 
     // METHODS
     VL_DEBUG_FUNC;  // Declare debug()
@@ -304,6 +324,127 @@ private:
         if (debug()>=9) ifrootp->dumpTree(cout, "    _simp: ");
     }
 
+    static int bodyInstrs(AstCaseItem* itemp) {
+        int instrs = 0;
+        for (AstNode* stmtp = itemp->bodysp(); stmtp; stmtp = stmtp->nextp()) {
+            instrs += V3InstrCount::count(stmtp, false);
+        }
+        return instrs;
+    }
+    static void searchLeaves(size_t lo, size_t hi, int& leaf, std::vector<int>& leafOf) {
+        // Number the leaf comparing each value, as split by replaceCaseSearchRecurse
+        if (hi - lo > CASE_SEARCH_LEAF_ITEMS) {
+            size_t mid = lo + (hi - lo) / 2;
+            searchLeaves(lo, mid, leaf, leafOf);
+            searchLeaves(mid, hi, leaf, leafOf);
+        } else {
+            for (size_t i = lo; i < hi; ++i) leafOf[i] = leaf;
+            ++leaf;
+        }
+    }
+
+    bool isCaseSearch(AstCase* nodep) {
+        // Wide case of many exact constants, as in address or opcode decoders
+        m_searchValues.clear();
+        m_searchDefaultp = NULL;
+        int width = nodep->exprp()->width();
+        if (width > VL_QUADSIZE || nodep->exprp()->isDouble()
+            || nodep->exprp()->isString()) return false;
+        for (AstCaseItem* itemp = nodep->itemsp();
+             itemp; itemp=VN_CAST(itemp->nextp(), CaseItem)) {
+            if (itemp->isDefault()) {
+                m_searchDefaultp = itemp;
+                continue;
+            }
+            for (AstNode* icondp = itemp->condsp(); icondp!=NULL; icondp=icondp->nextp()) {
+                AstConst* iconstp = VN_CAST(icondp, Const);
+                if (!iconstp || iconstp->width() != width) return false;
+                if (neverItem(nodep, iconstp)) continue;  // X in casez can't ever be executed
+                if (iconstp->num().isFourState()) return false;  // Masked compare
+                m_searchValues.push_back(SearchValue(iconstp->num().toUQuad(), iconstp, itemp));
+            }
+        }
+        // Earlier items have priority, so keep the first of any duplicate values
+        std::stable_sort(m_searchValues.begin(), m_searchValues.end());
+        SearchValues::iterator newEndit = m_searchValues.begin();
+        for (SearchValues::iterator it = m_searchValues.begin(); it != m_searchValues.end(); ++it) {
+            if (newEndit == m_searchValues.begin()
+                || (newEndit-1)->m_value != it->m_value) *newEndit++ = *it;
+        }
+        m_searchValues.erase(newEndit, m_searchValues.end());
+        if (m_searchValues.size() < CASE_SEARCH_MIN_ITEMS) return false;
+        // The default is cloned into every leaf, and an item into each leaf
+        // comparing one of its values, so only do this when those are cheap
+        if (m_searchDefaultp && bodyInstrs(m_searchDefaultp) > CASE_SEARCH_CLONE_INSTRS) {
+            return false;
+        }
+        std::vector<int> leafOf (m_searchValues.size());
+        int leaves = 0;
+        searchLeaves(0, m_searchValues.size(), leaves, leafOf);
+        std::map<AstCaseItem*, int> itemLeaf;  // Leaf of an item's first value
+        for (size_t i = 0; i < m_searchValues.size(); ++i) {
+            AstCaseItem* itemp = m_searchValues[i].m_itemp;
+            std::map<AstCaseItem*, int>::iterator it = itemLeaf.find(itemp);
+            if (it == itemLeaf.end()) {
+                itemLeaf.insert(std::make_pair(itemp, leafOf[i]));
+            } else if (it->second != leafOf[i] && it->second >= 0) {
+                if (bodyInstrs(itemp) > CASE_SEARCH_CLONE_INSTRS) return false;
+                it->second = -1;  // Checked
+            }
+        }
+        return true;
+    }
+
+    AstNode* replaceCaseSearchRecurse(AstNode* cexprp, size_t lo, size_t hi) {
+        FileLine* fl = cexprp->fileline();
+        if (hi - lo > CASE_SEARCH_LEAF_ITEMS) {
+            // IF(cexpr < middle value, lower half, upper half)
+            size_t mid = lo + (hi - lo) / 2;
+            AstNode* condp = new AstLt(fl, cexprp->cloneTree(false),
+                                       m_searchValues[mid].m_constp->cloneTree(false));
+            return new AstIf(fl, condp,
+                             replaceCaseSearchRecurse(cexprp, lo, mid),
+                             replaceCaseSearchRecurse(cexprp, mid, hi));
+        }
+        // Leaf: IF chain comparing each remaining value, items with
+        // several values in this range compare them together
+        AstNode* rootp = m_searchDefaultp && m_searchDefaultp->bodysp()
+            ? m_searchDefaultp->bodysp()->cloneTree(true) : NULL;
+        for (size_t i = hi; i-- > lo; ) {
+            AstCaseItem* itemp = m_searchValues[i].m_itemp;
+            bool done = false;
+            for (size_t j = i + 1; j < hi; ++j) {
+                if (m_searchValues[j].m_itemp == itemp) done = true;
+            }
+            if (done) continue;  // Already made IF for this item
+            AstNode* condp = NULL;
+            for (size_t j = lo; j <= i; ++j) {
+                if (m_searchValues[j].m_itemp != itemp) continue;
+                AstNode* eqp = AstEq::newTyped(fl, cexprp->cloneTree(false),
+                                               m_searchValues[j].m_constp->cloneTree(false));
+                condp = condp ? new AstLogOr(fl, condp, eqp) : eqp;
+            }
+            AstNode* bodysp = itemp->bodysp() ? itemp->bodysp()->cloneTree(true) : NULL;
+            rootp = new AstIf(fl, condp, bodysp, rootp);
+        }
+        return rootp;
+    }
+
+    void replaceCaseSearch(AstCase* nodep) {
+        // CASE(cexpr, ITEM(1, istmts1), ITEM(2, istmts2), ... ITEM(default, istmtsd))
+        // ->  IF(cexpr < 5, IF(cexpr == 1, istmts1, IF(cexpr == 2, istmts2, istmtsd)), ...)
+        AstNode* cexprp = nodep->exprp();
+        AstNode* rootp = replaceCaseSearchRecurse(cexprp, 0, m_searchValues.size());
+        m_searchValues.clear();
+        m_searchDefaultp = NULL;
+        // Handle any assertions
+        replaceCaseParallel(nodep, false);
+        if (debug()>=9 && rootp) rootp->dumpTree(cout, "     _new: ");
+        if (rootp) nodep->replaceWith(rootp);
+        else nodep->unlinkFrBack();
+        nodep->deleteTree(); VL_DANGLING(nodep);
+    }
+
     void replaceCaseComplicated(AstCase* nodep) {
         // CASEx(cexpr,ITEM(icond1,istmts1),ITEM(icond2,istmts2),ITEM(default,istmts3))
         // ->  IF((cexpr==icond1),istmts1,
@@ -469,6 +610,10 @@ private:
             // we can make a tree of statements to avoid extra comparisons
             ++m_statCaseFast;
             replaceCaseFast(nodep); VL_DANGLING(nodep);
+        } else if (isCaseSearch(nodep) && v3Global.opt.oCase()) {
+            // Many exact values; make a binary search tree of compares
+            ++m_statCaseSearch;
+            replaceCaseSearch(nodep); VL_DANGLING(nodep);
         } else {
             ++m_statCaseSlow;
             replaceCaseComplicated(nodep); VL_DANGLING(nodep);
@@ -486,6 +631,7 @@ public:
         m_caseWidth = 0;
         m_caseItems = 0;
         m_caseNoOverlapsAllCovered = false;
+        m_searchDefaultp = NULL;
         for (uint32_t i=0; i<(1UL<<CASE_OVERLAP_WIDTH); ++i) {
             m_valueItem[i] = NULL;
         }
@@ -493,6 +639,7 @@ public:
     }
     virtual ~CaseVisitor() {
         V3Stats::addStat("Optimizations, Cases parallelized", m_statCaseFast);
+        V3Stats::addStat("Optimizations, Cases searched", m_statCaseSearch);
         V3Stats::addStat("Optimizations, Cases complex", m_statCaseSlow);
     }
 };
@@ -232,6 +232,9 @@ private:
                               EmitCBaseVisitor::symClassVar()+" = this->__VlSymsp;\n"));
             funcp->addInitsp(new AstCStmt(nodep->fileline(),
                                           EmitCBaseVisitor::symTopAssign()+"\n"));
+            funcp->addInitsp(new AstCStmt(nodep->fileline(),
+                                          "VerilatedContextGuard __Vcontext_guard("
+                                          "vlSymsp->__Vm_contextp);\n"));
             m_scopep->addActivep(funcp);
             m_finalFuncp = funcp;
         }
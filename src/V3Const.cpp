@@ -550,6 +550,10 @@ private:
         if (!v3Global.opt.oAssemble()) return false;  // opt disabled
         // two same varref
         if (operandsSame(lhsp, rhsp)) return true;
+        // ~a[i:j] ~a[j-1:k]
+        if (VN_IS(lhsp, Not) && VN_IS(rhsp, Not)) {
+            return ifMergeAdjacent(VN_CAST(lhsp, Not)->lhsp(), VN_CAST(rhsp, Not)->lhsp());
+        }
         AstSel* lselp = VN_CAST(lhsp, Sel);
         AstSel* rselp = VN_CAST(rhsp, Sel);
         // a[i:0] a
@@ -2477,6 +2481,7 @@ private:
     // CONCAT(a[1],a[0]) -> a[1:0]
     TREEOPV("AstConcat{$lhsp.castSel, $rhsp.castSel, ifAdjacentSel(VN_CAST($lhsp,,Sel),,VN_CAST($rhsp,,Sel))}",  "replaceConcatSel(nodep)");
     TREEOPV("AstConcat{ifConcatMergeableBiop($lhsp), concatMergeable($lhsp,,$rhsp)}", "replaceConcatMerge(nodep)");
+    TREEOPV("AstConcat{$lhsp.castNot, $rhsp.castNot, v3Global.opt.oAssemble(), $lhsp->width()==VN_CAST($lhsp,,Not)->lhsp()->width(), $rhsp->width()==VN_CAST($rhsp,,Not)->lhsp()->width()}", "AstNot{AstConcat{$lhsp->op1p(),$rhsp->op1p()}}");  // {~a,~b} -> ~{a,b}
     // Common two-level operations that can be simplified
     TREEOP ("AstAnd {$lhsp.castConst,matchAndCond(nodep)}",           "DONE");
     TREEOP ("AstAnd {$lhsp.castOr, $rhsp.castOr, operandAndOrSame(nodep)}",     "replaceAndOr(nodep)");
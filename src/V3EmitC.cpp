@@ -27,22 +27,29 @@
 #include "V3EmitCBase.h"
 #include "V3Number.h"
 #include "V3PartitionGraph.h"
+#include "V3Stats.h"
 #include "V3TSP.h"
 
 #include <algorithm>
+#include <climits>
 #include <cmath>
 #include <cstdarg>
 #include <map>
+#include <memory>
 #include <vector>
+#include VL_INCLUDE_UNORDERED_MAP
 #include VL_INCLUDE_UNORDERED_SET
 
 #define VL_VALUE_STRING_MAX_WIDTH 8192  // We use a static char array in VL_VALUE_STRING
+#define EMITC_CACHE_LINE_BYTES 64  // Alignment of --threads mtask variable groups
 
 #define EMITC_NUM_CONSTW 8  // Number of VL_CONST_W_*X's in verilated.h (IE VL_CONST_W_8X is last)
 
 //######################################################################
 // Emit statements and math operators
 
+class EmitVarAccessOrder;
+
 class EmitCStmts : public EmitCBaseVisitor {
 private:
     typedef std::vector<const AstVar*> VarVec;
@@ -54,6 +61,7 @@ private:
     int         m_labelNum;             // Next label number
     int         m_splitSize;    // # of cfunc nodes placed into output file
     int         m_splitFilenum; // File number being created, 0 = primary
+    int         m_statAlignedGroups;  // Statistic tracking
 
 public:
     // METHODS
@@ -72,16 +80,19 @@ public:
     void displayNode(AstNode* nodep, AstScopeName* scopenamep,
                      const string& vformat, AstNode* exprsp, bool isScan);
     void displayEmit(AstNode* nodep, bool isScan);
+    void displayEmitFormatOps();
     void displayArg(AstNode* dispp, AstNode** elistp, bool isScan,
                     const string& vfmt, char fmtLetter);
 
     void emitVarDecl(const AstVar* nodep, const string& prefixIfImp);
     typedef enum {EVL_CLASS_IO, EVL_CLASS_SIG, EVL_CLASS_TEMP, EVL_CLASS_PAR, EVL_CLASS_ALL,
                   EVL_FUNC_ALL} EisWhich;
-    void emitVarList(AstNode* firstp, EisWhich which, const string& prefixIfImp);
-    static void emitVarSort(const VarSortMap& vmap, VarVec* sortedp);
-    void emitSortedVarList(const VarVec& anons,
-                           const VarVec& nonanons, const string& prefixIfImp);
+    void emitVarList(AstNode* firstp, EisWhich which, const string& prefixIfImp,
+                     const EmitVarAccessOrder* accessp = NULL);
+    static void emitVarSort(const VarSortMap& vmap, const EmitVarAccessOrder* accessp,
+                            VarVec* sortedp);
+    void emitSortedVarList(const VarVec& anons, const VarVec& nonanons,
+                           const string& prefixIfImp, bool alignGroups);
     void emitVarCtors(bool* firstp);
     void emitCtorSep(bool* firstp);
     bool emitSimpleOk(AstNodeMath* nodep);
@@ -107,13 +118,21 @@ public:
             puts("["+cvtToStr(arrayp->elementsConst())+"]");
         }
     }
-    void emitVarCmtChg(const AstVar* varp, string* curVarCmtp) {
+    void emitVarCmtChg(const AstVar* varp, string* curVarCmtp, bool alignGroups) {
         string newVarCmt = varp->mtasksString();
         if (*curVarCmtp != newVarCmt) {
             *curVarCmtp = newVarCmt;
             if (v3Global.opt.threads()) {
                 puts("// Begin mtask footprint "+*curVarCmtp+"\n");
             }
+            // Start each footprint on its own cache line, so variables
+            // written by mtasks on different threads don't false share.
+            // The alignment is fixed here, not by a macro, so the class
+            // layout can't differ between C++ standards or compile flags.
+            if (alignGroups && !varp->isStatic()) {
+                puts("VL_ATTR_ALIGNED("+cvtToStr(EMITC_CACHE_LINE_BYTES)+") ");
+                ++m_statAlignedGroups;
+            }
         }
     }
     void emitTypedefs(AstNode* firstp) {
@@ -932,6 +951,7 @@ public:
         m_labelNum = 0;
         m_splitSize = 0;
         m_splitFilenum = 0;
+        m_statAlignedGroups = 0;
     }
 
 public:
@@ -944,7 +964,12 @@ public:
         m_trackText = trackText;
         iterate(nodep);
     }
-    virtual ~EmitCStmts() {}
+    virtual ~EmitCStmts() {
+        if (m_statAlignedGroups) {
+            V3Stats::addStatSum("Emit, mtask footprints cache line aligned",
+                                m_statAlignedGroups);
+        }
+    }
 };
 
 //######################################################################
@@ -991,6 +1016,48 @@ public:
 
 unsigned EmitVarTspSorter::m_serialNext = 0;
 
+//######################################################################
+// Establish variable sort order in serial mode
+
+class EmitVarAccessOrder : public AstNVisitor {
+    // Number each variable by the first CFunc (in statement order) that
+    // references it, so variables used together are declared together.
+private:
+    // MEMBERS
+    typedef vl_unordered_map<const AstVar*, int> VarOrderMap;
+    VarOrderMap m_order;  // First function number referencing each variable
+    int m_funcNum;  // Current function number, 0 = not under a function
+    // VISITORS
+    virtual void visit(AstCFunc* nodep) {
+        ++m_funcNum;
+        iterateChildren(nodep);
+    }
+    virtual void visit(AstVarRef* nodep) {
+        // Insert won't replace, so this keeps the first function
+        if (m_funcNum) m_order.insert(make_pair(nodep->varp(), m_funcNum));
+    }
+    virtual void visit(AstNode* nodep) {
+        iterateChildren(nodep);
+    }
+public:
+    // CONSTRUCTORS
+    explicit EmitVarAccessOrder(AstNode* firstp)
+        : m_funcNum(0) {
+        for (AstNode* nodep = firstp; nodep; nodep = nodep->nextp()) {
+            if (VN_IS(nodep, CFunc)) iterate(nodep);
+        }
+    }
+    virtual ~EmitVarAccessOrder() {}
+    // METHODS
+    int order(const AstVar* varp) const {
+        VarOrderMap::const_iterator it = m_order.find(varp);
+        return (it != m_order.end()) ? it->second : INT_MAX;  // Unreferenced last
+    }
+    bool operator()(const AstVar* lhsp, const AstVar* rhsp) const {
+        return order(lhsp) < order(rhsp);
+    }
+};
+
 //######################################################################
 // Internal EmitC implementation
 
@@ -1116,8 +1183,11 @@ class EmitCImp : EmitCStmts {
         }
         puts("Verilated::mtaskId(" + cvtToStr(curExecMTaskp->id()) + ");\n");
 
-        // The actual body of calls to leaf functions
+        // The actual body of calls to leaf functions, in the model's context
+        puts("{\n");
+        puts("VerilatedContextGuard __Vcontext_guard(vlSymsp->__Vm_contextp);\n");
         iterateAndNextNull(nodep->stmtsp());
+        puts("}\n");
 
         if (v3Global.opt.profThreads()) {
             // Leave this if() here, as don't want to call VL_RDTSC_Q unless profiling
@@ -1422,7 +1492,7 @@ class EmitCImp : EmitCStmts {
     void emitCellCtors(AstNodeModule* modp);
     void emitSensitives();
     // Medium level
-    void emitCtorImp(AstNodeModule* modp);
+    void emitCtorImp(AstNodeModule* modp, bool withContext = false);
     void emitConfigureImp(AstNodeModule* modp);
     void emitCoverageDecl(AstNodeModule* modp);
     void emitCoverageImp(AstNodeModule* modp);
@@ -1664,11 +1734,69 @@ struct EmitDispState {
     }
 } emitDispState;
 
+void EmitCStmts::displayEmitFormatOps() {
+    // Emit the format as a table of pre-parsed conversions, so the runtime
+    // doesn't need to parse the format string on every call.
+    // Must match the format string parsing in verilated.cpp's _vl_vsformat.
+    puts("static const VerilatedFormatOp __Vfmt[] = {\n");
+    const string& format = emitDispState.m_format;
+    string text;
+    for (string::const_iterator pos = format.begin(); ; ++pos) {
+        if (pos != format.end() && *pos != '%') {
+            text += *pos;
+            continue;
+        }
+        string spec;
+        char fmt = '\0';
+        bool widthSet = false;
+        int width = 0;
+        if (pos != format.end()) {
+            spec += *pos++;
+            for (; pos != format.end(); ++pos) {
+                spec += *pos;
+                if (isdigit(*pos)) {
+                    widthSet = true;
+                    width = width * 10 + (*pos - '0');
+                } else if (*pos != '.') {
+                    break;
+                }
+            }
+            UASSERT(pos != format.end(), "Display format ends in a %: "<<format);
+            if (*pos == '%') {
+                text += '%';
+                continue;
+            }
+            fmt = *pos;
+        }
+        bool zeroPad = spec.length() > 1 && spec[1] == '0';
+        bool needSpec = (fmt == 'e' || fmt == 'f' || fmt == 'g');
+        puts("{");
+        ofp()->putsQuoted(text);
+        puts(", "+cvtToStr(text.length()));
+        puts(fmt ? string(", '")+fmt+"'" : string(", '\\0'"));
+        puts(widthSet ? ", true" : ", false");
+        puts(zeroPad ? ", true" : ", false");
+        puts(", "+cvtToStr(width)+", ");
+        if (needSpec) ofp()->putsQuoted(spec);
+        else puts("NULL");
+        puts("},\n");
+        if (!fmt) break;
+        text = "";
+    }
+    puts("};\n");
+}
+
 void EmitCStmts::displayEmit(AstNode* nodep, bool isScan) {
     if (emitDispState.m_format == ""
         && VN_IS(nodep, Display)) {  // not fscanf etc, as they need to return value
         // NOP
     } else {
+        // Statements use a pre-parsed format; expressions can't declare one
+        bool formatOps = VN_IS(nodep, Display) || VN_IS(nodep, SFormat);
+        if (formatOps) {
+            puts("{\n");
+            displayEmitFormatOps();
+        }
         // Format
         bool isStmt = false;
         if (const AstFScanF* dispp = VN_CAST(nodep, FScanF)) {
@@ -1707,7 +1835,8 @@ void EmitCStmts::displayEmit(AstNode* nodep, bool isScan) {
         } else {
             nodep->v3fatalSrc("Unknown displayEmit node type");
         }
-        ofp()->putsQuoted(emitDispState.m_format);
+        if (formatOps) puts("__Vfmt");
+        else ofp()->putsQuoted(emitDispState.m_format);
         // Arguments
         for (unsigned i=0; i < emitDispState.m_argsp.size(); i++) {
             puts(",");
@@ -1730,6 +1859,7 @@ void EmitCStmts::displayEmit(AstNode* nodep, bool isScan) {
         puts(")");
         if (isStmt) puts(";\n");
         else puts(" ");
+        if (formatOps) puts("}\n");
         // Prep for next
         emitDispState.clear();
     }
@@ -1882,6 +2012,9 @@ void EmitCImp::emitMTaskVertexCtors(bool* firstp) {
 
     emitCtorSep(firstp);
     puts("__Vm_mt_final(" + cvtToStr(finalEdgesInCt) + ")");
+    // Threads other than the caller running initial/settle logic
+    emitCtorSep(firstp);
+    puts("__Vm_mt_init(" + cvtToStr(v3Global.opt.threads() - 1) + ")");
 
     // This will flip to 'true' before the start of the 0th cycle.
     emitCtorSep(firstp); puts("__Vm_threadPoolp(NULL)");
@@ -1889,12 +2022,17 @@ void EmitCImp::emitMTaskVertexCtors(bool* firstp) {
         emitCtorSep(firstp); puts("__Vm_profile_cycle_start(0)");
     }
     emitCtorSep(firstp); puts("__Vm_even_cycle(false)");
+    emitCtorSep(firstp); puts("__Vm_init_even(false)");
 }
 
-void EmitCImp::emitCtorImp(AstNodeModule* modp) {
+void EmitCImp::emitCtorImp(AstNodeModule* modp, bool withContext) {
     puts("\n");
     bool first = true;
-    if (optSystemC() && modp->isTop()) {
+    if (withContext) {
+        puts(modClassName(modp)+"::"+modClassName(modp)
+             +"(VerilatedContext* contextp, const char* __VCname) : VerilatedModule(__VCname)");
+        first = false;
+    } else if (optSystemC() && modp->isTop()) {
         puts("VL_SC_CTOR_IMP("+modClassName(modp)+")");
     } else {
         puts("VL_CTOR_IMP("+modClassName(modp)+")");
@@ -1905,6 +2043,11 @@ void EmitCImp::emitCtorImp(AstNodeModule* modp) {
         emitMTaskVertexCtors(&first);
     }
     puts(" {\n");
+    if (modp->isTop()) {
+        // Before the symbol table is created, as it records the context
+        puts(string("VerilatedContextGuard __Vcontext_guard(")
+             +(withContext ? "contextp" : "NULL")+");\n");
+    }
     emitCellCtors(modp);
     emitSensitives();
 
@@ -2188,6 +2331,7 @@ void EmitCImp::emitWrapEval(AstNodeModule* modp) {
     puts("VL_DEBUG_IF(VL_DBG_MSGF(\"+++++TOP Evaluate "+modClassName(modp)+"::eval\\n\"); );\n");
     puts(EmitCBaseVisitor::symClassVar()+" = this->__VlSymsp;  // Setup global symbol table\n");
     puts(EmitCBaseVisitor::symTopAssign()+"\n");
+    puts("VerilatedContextGuard __Vcontext_guard(vlSymsp->__Vm_contextp);\n");
     puts("#ifdef VL_DEBUG\n");
     putsDecoration("// Debug assertions\n");
     puts(protect("_eval_debug_assertions")+"();\n");
@@ -2273,7 +2417,8 @@ void EmitCImp::emitWrapEval(AstNodeModule* modp) {
 //----------------------------------------------------------------------
 // Top interface/ implementation
 
-void EmitCStmts::emitVarList(AstNode* firstp, EisWhich which, const string& prefixIfImp) {
+void EmitCStmts::emitVarList(AstNode* firstp, EisWhich which, const string& prefixIfImp,
+                             const EmitVarAccessOrder* accessp) {
     // Put out a list of signal declarations
     // in order of 0:clocks, 1:vluint8, 2:vluint16, 4:vluint32, 5:vluint64, 6:wide, 7:arrays
     // This aids cache packing and locality
@@ -2330,24 +2475,36 @@ void EmitCStmts::emitVarList(AstNode* firstp, EisWhich which, const string& pref
         }
     }
 
+    // Class members only; function locals and static definitions don't
+    // affect the object layout
+    bool classLayout = (which != EVL_FUNC_ALL && prefixIfImp == "");
+
     VarVec anons;
     VarVec nonanons;
-    emitVarSort(varAnonMap, &anons);
-    emitVarSort(varNonanonMap, &nonanons);
-    emitSortedVarList(anons, nonanons, prefixIfImp);
+    emitVarSort(varAnonMap, accessp, &anons);
+    emitVarSort(varNonanonMap, accessp, &nonanons);
+    emitSortedVarList(anons, nonanons, prefixIfImp,
+                      classLayout && v3Global.opt.mtasks());
 }
 
-void EmitCStmts::emitVarSort(const VarSortMap& vmap, VarVec* sortedp) {
+void EmitCStmts::emitVarSort(const VarSortMap& vmap, const EmitVarAccessOrder* accessp,
+                             VarVec* sortedp) {
     UASSERT(sortedp->empty(), "Sorted should be initially empty");
     if (!v3Global.opt.mtasks()) {
         // Plain old serial mode. Sort by size, from small to large,
         // to optimize for both packing and small offsets in code.
+        // Within a size, cluster by the first function accessing each
+        // variable, so a function's working set shares cache lines.
         for (VarSortMap::const_iterator it = vmap.begin();
              it != vmap.end(); ++it) {
+            size_t start = sortedp->size();
             for (VarVec::const_iterator jt = it->second.begin();
                  jt != it->second.end(); ++jt) {
                 sortedp->push_back(*jt);
             }
+            if (accessp) {
+                std::stable_sort(sortedp->begin() + start, sortedp->end(), *accessp);
+            }
         }
         return;
     }
@@ -2391,9 +2548,8 @@ void EmitCStmts::emitVarSort(const VarSortMap& vmap, VarVec* sortedp) {
     }
 }
 
-void EmitCStmts::emitSortedVarList(const VarVec& anons,
-                                   const VarVec& nonanons,
-                                   const string& prefixIfImp) {
+void EmitCStmts::emitSortedVarList(const VarVec& anons, const VarVec& nonanons,
+                                   const string& prefixIfImp, bool alignGroups) {
     string curVarCmt;
     // Output anons
     {
@@ -2422,7 +2578,7 @@ void EmitCStmts::emitSortedVarList(const VarVec& anons,
                     if (anonL1s != 1) puts("struct {\n");
                     for (int l0=0; l0<lim && it != anons.end(); ++l0) {
                         const AstVar* varp = *it;
-                        emitVarCmtChg(varp, &curVarCmt);
+                        emitVarCmtChg(varp, &curVarCmt, alignGroups);
                         emitVarDecl(varp, prefixIfImp);
                         ++it;
                     }
@@ -2435,14 +2591,14 @@ void EmitCStmts::emitSortedVarList(const VarVec& anons,
         // Leftovers, just in case off by one error somewhere above
         for (; it != anons.end(); ++it) {
             const AstVar* varp = *it;
-            emitVarCmtChg(varp, &curVarCmt);
+            emitVarCmtChg(varp, &curVarCmt, alignGroups);
             emitVarDecl(varp, prefixIfImp);
         }
     }
     // Output nonanons
     for (VarVec::const_iterator it = nonanons.begin(); it != nonanons.end(); ++it) {
         const AstVar* varp = *it;
-        emitVarCmtChg(varp, &curVarCmt);
+        emitVarCmtChg(varp, &curVarCmt, alignGroups);
         emitVarDecl(varp, prefixIfImp);
     }
 }
@@ -2523,6 +2679,8 @@ void EmitCImp::emitMTaskState() {
     // fully done executing, for "half wave" scheduling. For now we wait
     // for all mtasks though.
     puts("VlMTaskVertex __Vm_mt_final;\n");
+    // Blocks _eval_initial/_eval_settle until their threads are done
+    puts("VlMTaskVertex __Vm_mt_init;\n");
     puts("VlThreadPool* __Vm_threadPoolp;\n");
 
     if (v3Global.opt.profThreads()) {
@@ -2535,6 +2693,7 @@ void EmitCImp::emitMTaskState() {
     }
 
     puts("bool __Vm_even_cycle;\n");
+    puts("bool __Vm_init_even;\n");
 }
 
 void EmitCImp::emitInt(AstNodeModule* modp) {
@@ -2612,18 +2771,22 @@ void EmitCImp::emitInt(AstNodeModule* modp) {
 
     emitTypedefs(modp->stmtsp());
 
+    // Serial mode clusters members by first use; computed once for all lists
+    vl_unique_ptr<EmitVarAccessOrder> accessp;
+    if (!v3Global.opt.mtasks()) accessp.reset(new EmitVarAccessOrder(modp->stmtsp()));
+
     puts("\n// PORTS\n");
     if (modp->isTop()) puts("// The application code writes and reads these signals to\n");
     if (modp->isTop()) puts("// propagate new values into/out from the Verilated model.\n");
-    emitVarList(modp->stmtsp(), EVL_CLASS_IO, "");
+    emitVarList(modp->stmtsp(), EVL_CLASS_IO, "", accessp.get());
 
     puts("\n// LOCAL SIGNALS\n");
     if (modp->isTop()) puts("// Internals; generally not touched by application code\n");
-    emitVarList(modp->stmtsp(), EVL_CLASS_SIG, "");
+    emitVarList(modp->stmtsp(), EVL_CLASS_SIG, "", accessp.get());
 
     puts("\n// LOCAL VARIABLES\n");
     if (modp->isTop()) puts("// Internals; generally not touched by application code\n");
-    emitVarList(modp->stmtsp(), EVL_CLASS_TEMP, "");
+    emitVarList(modp->stmtsp(), EVL_CLASS_TEMP, "", accessp.get());
 
     puts("\n// INTERNAL VARIABLES\n");
     if (modp->isTop()) puts("// Internals; generally not touched by application code\n");
@@ -2643,7 +2806,7 @@ void EmitCImp::emitInt(AstNodeModule* modp) {
     puts("\n// PARAMETERS\n");
     if (modp->isTop()) puts("// Parameters marked /*verilator public*/ for use by application code\n");
     ofp()->putsPrivate(false);  // public:
-    emitVarList(modp->stmtsp(), EVL_CLASS_PAR, "");  // Only those that are non-CONST
+    emitVarList(modp->stmtsp(), EVL_CLASS_PAR, "", accessp.get());  // Only non-CONST
     for (AstNode* nodep = modp->stmtsp(); nodep; nodep = nodep->nextp()) {
         if (const AstVar* varp = VN_CAST(nodep, Var)) {
             if (varp->isParam() && (varp->isUsedParam() || varp->isSigPublic())) {
@@ -2689,6 +2852,11 @@ void EmitCImp::emitInt(AstNodeModule* modp) {
             puts("/// single model invisible with respect to DPI scope names.\n");
         }
         puts(modClassName(modp)+"(const char* name = \"TOP\");\n");
+        if (modp->isTop()) {
+            puts("/// Construct the model with its own simulation context, so multiple\n");
+            puts("/// models may be independently simulated in one process\n");
+            puts(modClassName(modp)+"(VerilatedContext* contextp, const char* name = \"TOP\");\n");
+        }
         if (modp->isTop()) puts("/// Destroy the model; called (often implicitly) by application code\n");
         puts("~"+modClassName(modp)+"();\n");
     }
@@ -2788,6 +2956,7 @@ void EmitCImp::emitImp(AstNodeModule* modp) {
     if (m_slow && splitFilenum()==0) {
         puts("\n//--------------------\n");
         emitCtorImp(modp);
+        if (modp->isTop() && !optSystemC()) emitCtorImp(modp, true);
         emitConfigureImp(modp);
         emitDestructorImp(modp);
         emitSavableImp(modp);
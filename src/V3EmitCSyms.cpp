@@ -429,6 +429,20 @@ void EmitCSyms::emitSymHdr() {
         }
     }
 
+    bool instTables = false;
+    for (AstNodeModule* modp = v3Global.rootp()->modulesp();
+         modp; modp = VN_CAST(modp->nextp(), NodeModule)) {
+        if (!modp->instTable()) continue;
+        if (!instTables) puts("\n// INSTANCE TABLES\n");
+        instTables = true;
+        int instances = 0;
+        for (AstNode* stmtp = modp->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+            if (VN_IS(stmtp, Scope)) ++instances;
+        }
+        ofp()->printf("%-30s ", (modClassName(modp)+"*").c_str());
+        puts(modp->instTableName()+"["+cvtToStr(instances)+"];\n");
+    }
+
     if (m_coverBins) {
         puts("\n// COVERAGE\n");
         puts("uint32_t __Vcoverage["); puts(cvtToStr(m_coverBins)); puts("];\n");
@@ -617,6 +631,21 @@ void EmitCSyms::emitSymImp() {
         }
     }
 
+    for (AstNodeModule* modp = v3Global.rootp()->modulesp();
+         modp; modp = VN_CAST(modp->nextp(), NodeModule)) {
+        if (!modp->instTable()) continue;
+        puts("// Setup table of each instance of "+modClassName(modp)+"\n");
+        int instance = 0;
+        for (AstNode* stmtp = modp->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+            if (AstScope* scopep = VN_CAST(stmtp, Scope)) {
+                checkSplit(false);
+                puts(modp->instTableName()+"["+cvtToStr(instance++)+"] = &");
+                puts(scopep->nameDotless()+";\n");
+                ++m_numStmts;
+            }
+        }
+    }
+
     puts("// Setup each module's pointer back to symbol table (for public functions)\n");
     puts("TOPp->"+protect("__Vconfigure")+"(this, true);\n");
     for (std::vector<ScopeModPair>::iterator it = m_scopes.begin(); it != m_scopes.end(); ++it) {
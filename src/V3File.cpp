@@ -34,6 +34,7 @@
 #include <iomanip>
 #include <map>
 #include <memory>
+#include <sstream>
 #include <sys/stat.h>
 #include <sys/types.h>
 
@@ -72,6 +73,7 @@ class V3FileDependImp {
         bool            m_target;       // True if write, else read
         bool            m_exists;
         string          m_filename;     // Filename
+        string          m_hash;         // Content hash, sources only
         struct stat     m_stat;         // Stat information
     public:
         DependFile(const string& filename, bool target)
@@ -89,6 +91,8 @@ class V3FileDependImp {
         time_t cnstime() const { return VL_STAT_CTIME_NSEC(m_stat); }  // Nanoseconds
         time_t mstime() const { return m_stat.st_mtime; }  // Seconds
         time_t mnstime() const { return VL_STAT_MTIME_NSEC(m_stat); }  // Nanoseconds
+        const string& hash() const { return m_hash; }
+        void loadHash() { m_hash = contentsHash(filename()); }
         void loadStats() {
             if (!m_stat.st_mtime) {
                 string fn = filename();
@@ -109,6 +113,14 @@ class V3FileDependImp {
     std::set<string> m_filenameSet;  // Files generated (elim duplicates)
     std::set<DependFile> m_filenameList;  // Files sourced/generated
 
+    static string contentsHash(const string& filename) {
+        // "-" if unreadable, so never matches
+        const vl_unique_ptr<std::ifstream> ifp (V3File::new_ifstream_nodepend(filename));
+        if (ifp->fail()) return "-";
+        std::ostringstream contents;
+        contents<<ifp->rdbuf();
+        return VHashSha256(contents.str()).digestHex();
+    }
     static string stripQuotes(const string& in) {
         string pretty = in;
         string::size_type pos;
@@ -123,6 +135,7 @@ public:
             m_filenameSet.insert(filename);
             DependFile df (filename, false);
             df.loadStats();  // Get size now, in case changes during the run
+            if (v3Global.opt.skipIdentical().isTrue()) df.loadHash();  // Likewise
             m_filenameList.insert(df);
         }
     }
@@ -132,6 +145,10 @@ public:
             m_filenameList.insert(DependFile(filename, true));
         }
     }
+    static string timesHeader() {
+        return string("# DESCR")+"IPTION: Verilator output: Timestamp and hash data"
+            " for --skip-identical.  Delete at will.";
+    }
     void writeDepend(const string& filename);
     std::vector<string> getAllDeps() const;
     void writeTimes(const string& filename, const string& cmdlineIn);
@@ -193,7 +210,7 @@ inline void V3FileDependImp::writeTimes(const string& filename, const string& cm
     if (ofp->fail()) v3fatal("Can't write "<<filename);
 
     string cmdline = stripQuotes(cmdlineIn);
-    *ofp<<"# DESCR"<<"IPTION: Verilator output: Timestamp data for --skip-identical.  Delete at will."<<endl;
+    *ofp<<timesHeader()<<endl;
     *ofp<<"C \""<<cmdline<<"\""<<endl;
 
     for (std::set<DependFile>::iterator iter=m_filenameList.begin();
@@ -216,6 +233,7 @@ inline void V3FileDependImp::writeTimes(const string& filename, const string& cm
         *ofp<<" "<<std::setw(11)<<iter->cnstime();
         *ofp<<" "<<std::setw(11)<<iter->mstime();
         *ofp<<" "<<std::setw(11)<<iter->mnstime();
+        *ofp<<" "<<(iter->hash().empty() ? "-" : iter->hash());
         *ofp<<" \""<<iter->filename()<<"\"";
         *ofp<<endl;
     }
@@ -228,7 +246,11 @@ inline bool V3FileDependImp::checkTimes(const string& filename, const string& cm
         return false;
     }
     {
-        string ignore = V3Os::getline(*ifp);  if (ignore.empty()) { /*used*/ }
+        string header = V3Os::getline(*ifp);
+        if (header != timesHeader()) {
+            UINFO(2,"   --check-times failed: different format\n");
+            return false;
+        }
     }
     {
         char   chkDir;   *ifp>>chkDir;
@@ -250,6 +272,7 @@ inline bool V3FileDependImp::checkTimes(const string& filename, const string& cm
         time_t chkCnstime; *ifp>>chkCnstime;
         time_t chkMstime; *ifp>>chkMstime;
         time_t chkMnstime; *ifp>>chkMnstime;
+        string chkHash;  *ifp>>chkHash;
         char   quote;    *ifp>>quote;
         string chkFilename = V3Os::getline(*ifp, '"');
 
@@ -278,6 +301,12 @@ inline bool V3FileDependImp::checkTimes(const string& filename, const string& cm
                   && chkStat.st_mtime <= (chkMstime + 20)
                   // Not comparing chkMnstime
                     )) {
+                // A source that was only touched, or rewritten with the same
+                // contents (e.g. by a version control checkout) is still current
+                if (chkDir == 'S' && chkHash != "-" && contentsHash(chkFilename) == chkHash) {
+                    UINFO(2,"   --check-times same contents: "<<chkFilename<<endl);
+                    continue;
+                }
                 UINFO(2,"   --check-times failed: out-of-date "<<chkFilename
                       <<"; "<<chkStat.st_size<<"=?"<<chkSize
                       <<" "<<chkStat.st_ctime<<"."<<VL_STAT_CTIME_NSEC(chkStat)
@@ -927,15 +956,19 @@ void V3OutFormatter::printf(const char* fmt...) {
 // V3OutFormatter: A class for printing to a file, with automatic indentation of C++ code.
 
 V3OutFile::V3OutFile(const string& filename, V3OutFormatter::Language lang)
-    : V3OutFormatter(filename, lang) {
+    : V3OutFormatter(filename, lang)
+    , m_usedBytes(0) {
     if ((m_fp = V3File::new_fopen_w(filename)) == NULL) {
         v3fatal("Cannot write "<<filename);
     }
+    m_bufferp = new char[WRITE_BUFFER_SIZE_BYTES];
 }
 
 V3OutFile::~V3OutFile() {
+    writeBlock();
     if (m_fp) fclose(m_fp);
     m_fp = NULL;
+    delete[] m_bufferp; m_bufferp = NULL;
 }
 
 void V3OutFile::putsForceIncs() {
@@ -175,15 +175,26 @@ public:
 // V3OutFile: A class for printing to a file, with automatic indentation of C++ code.
 
 class V3OutFile : public V3OutFormatter {
+    // TYPES
+    enum MiscConsts { WRITE_BUFFER_SIZE_BYTES = 128 * 1024 };
     // MEMBERS
     FILE*       m_fp;
+    size_t      m_usedBytes;  // Number of bytes stored in m_bufferp
+    char*       m_bufferp;  // Output buffer, as per-character stdio calls are slow
 public:
     V3OutFile(const string& filename, V3OutFormatter::Language lang);
     virtual ~V3OutFile();
     void putsForceIncs();
 private:
+    void writeBlock() {
+        if (VL_LIKELY(m_usedBytes > 0)) fwrite(m_bufferp, m_usedBytes, 1, m_fp);
+        m_usedBytes = 0;
+    }
     // CALLBACKS
-    virtual void putcOutput(char chr) { fputc(chr, m_fp); }
+    virtual void putcOutput(char chr) {
+        m_bufferp[m_usedBytes++] = chr;
+        if (VL_UNLIKELY(m_usedBytes >= WRITE_BUFFER_SIZE_BYTES)) writeBlock();
+    }
 };
 
 class V3OutCFile : public V3OutFile {
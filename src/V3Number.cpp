@@ -1046,6 +1046,11 @@ V3Number& V3Number::opNot(const V3Number& lhs) {
     NUM_ASSERT_LOGIC_ARGS1(lhs);
     // op i, L(lhs) bit return
     setZero();
+    if (!lhs.isFourState()) {  // Word-at-a-time
+        for (int i=0; i<words(); ++i) m_value[i] = ~lhs.valueWordExt(i);
+        opCleanThis();
+        return *this;
+    }
     for (int bit=0; bit<this->width(); bit++) {
         if (lhs.bitIs0(bit))       { setBit(bit, 1); }
         else if (lhs.bitIsXZ(bit)) { setBit(bit,'x'); }
@@ -1058,6 +1063,11 @@ V3Number& V3Number::opAnd(const V3Number& lhs, const V3Number& rhs) {
     NUM_ASSERT_LOGIC_ARGS2(lhs, rhs);
     // i op j, max(L(lhs),L(rhs)) bit return, careful need to X/Z extend.
     setZero();
+    if (!lhs.isFourState() && !rhs.isFourState()) {  // Word-at-a-time
+        for (int i=0; i<words(); ++i) m_value[i] = lhs.valueWordExt(i) & rhs.valueWordExt(i);
+        opCleanThis();
+        return *this;
+    }
     for (int bit=0; bit<this->width(); bit++) {
         if (lhs.bitIs1(bit) && rhs.bitIs1(bit))  { setBit(bit, 1); }
         else if (lhs.bitIs0(bit) || rhs.bitIs0(bit)) ;  // 0
@@ -1071,6 +1081,11 @@ V3Number& V3Number::opOr(const V3Number& lhs, const V3Number& rhs) {
     NUM_ASSERT_LOGIC_ARGS2(lhs, rhs);
     // i op j, max(L(lhs),L(rhs)) bit return, careful need to X/Z extend.
     setZero();
+    if (!lhs.isFourState() && !rhs.isFourState()) {  // Word-at-a-time
+        for (int i=0; i<words(); ++i) m_value[i] = lhs.valueWordExt(i) | rhs.valueWordExt(i);
+        opCleanThis();
+        return *this;
+    }
     for (int bit=0; bit<this->width(); bit++) {
         if (lhs.bitIs1(bit) || rhs.bitIs1(bit))  { setBit(bit, 1); }
         else if (lhs.bitIs0(bit) && rhs.bitIs0(bit)) ;  // 0
@@ -1092,6 +1107,11 @@ V3Number& V3Number::opXor(const V3Number& lhs, const V3Number& rhs) {
     NUM_ASSERT_OP_ARGS2(lhs, rhs);
     NUM_ASSERT_LOGIC_ARGS2(lhs, rhs);
     setZero();
+    if (!lhs.isFourState() && !rhs.isFourState()) {  // Word-at-a-time
+        for (int i=0; i<words(); ++i) m_value[i] = lhs.valueWordExt(i) ^ rhs.valueWordExt(i);
+        opCleanThis();
+        return *this;
+    }
     for (int bit=0; bit<this->width(); bit++) {
         if (lhs.bitIs1(bit) && rhs.bitIs0(bit))  { setBit(bit, 1); }
         else if (lhs.bitIs0(bit) && rhs.bitIs1(bit))  { setBit(bit, 1); }
@@ -1106,6 +1126,11 @@ V3Number& V3Number::opXnor(const V3Number& lhs, const V3Number& rhs) {
     NUM_ASSERT_OP_ARGS2(lhs, rhs);
     NUM_ASSERT_LOGIC_ARGS2(lhs, rhs);
     setZero();
+    if (!lhs.isFourState() && !rhs.isFourState()) {  // Word-at-a-time
+        for (int i=0; i<words(); ++i) m_value[i] = ~(lhs.valueWordExt(i) ^ rhs.valueWordExt(i));
+        opCleanThis();
+        return *this;
+    }
     for (int bit=0; bit<this->width(); bit++) {
         if (lhs.bitIs1(bit) && rhs.bitIs1(bit))  { setBit(bit, 1); }
         else if (lhs.bitIs0(bit) && rhs.bitIs0(bit))  { setBit(bit, 1); }
@@ -1321,6 +1346,12 @@ V3Number& V3Number::opEq(const V3Number& lhs, const V3Number& rhs) {
     NUM_ASSERT_OP_ARGS2(lhs, rhs);
     if (lhs.isString()) return opEqN(lhs, rhs);
     if (lhs.isDouble()) return opEqD(lhs, rhs);
+    if (!lhs.isFourState() && !rhs.isFourState()) {  // Word-at-a-time
+        for (int i=0; i < std::max(lhs.words(), rhs.words()); ++i) {
+            if (lhs.valueWordExt(i) != rhs.valueWordExt(i)) return setSingleBits(0);
+        }
+        return setSingleBits(1);
+    }
     char outc = 1;
     for (int bit=0; bit < std::max(lhs.width(), rhs.width()); bit++) {
         if (lhs.bitIs1(bit) && rhs.bitIs0(bit)) { outc = 0; goto last; }
@@ -1337,6 +1368,12 @@ V3Number& V3Number::opNeq(const V3Number& lhs, const V3Number& rhs) {
     NUM_ASSERT_OP_ARGS2(lhs, rhs);
     if (lhs.isString()) return opNeqN(lhs, rhs);
     if (lhs.isDouble()) return opNeqD(lhs, rhs);
+    if (!lhs.isFourState() && !rhs.isFourState()) {  // Word-at-a-time
+        for (int i=0; i < std::max(lhs.words(), rhs.words()); ++i) {
+            if (lhs.valueWordExt(i) != rhs.valueWordExt(i)) return setSingleBits(1);
+        }
+        return setSingleBits(0);
+    }
     char outc = 0;
     for (int bit=0; bit < std::max(lhs.width(), rhs.width()); bit++) {
         if (lhs.bitIs1(bit) && rhs.bitIs0(bit)) { outc = 1; goto last; }
@@ -1354,8 +1391,9 @@ bool V3Number::isCaseEq(const V3Number& rhs) const {
     if (isDouble()) return toDouble() == rhs.toDouble();
     if (this->width() != rhs.width()) return false;
 
-    for (int bit=0; bit < std::max(this->width(), rhs.width()); bit++) {
-        if (this->bitIs(bit) != rhs.bitIs(bit)) { return false; }
+    for (int i=0; i < words(); ++i) {
+        if (valueWordExt(i) != rhs.valueWordExt(i)) return false;
+        if (valueXWordExt(i) != rhs.valueXWordExt(i)) return false;
     }
     return true;
 }
@@ -1594,14 +1632,14 @@ V3Number& V3Number::opAdd(const V3Number& lhs, const V3Number& rhs) {
     if (lhs.isFourState() || rhs.isFourState()) return setAllBitsX();
     setZero();
     // Addem
-    int carry=0;
-    for (int bit=0; bit<this->width(); bit++) {
-        int sum = ((lhs.bitIs1(bit)?1:0) + (rhs.bitIs1(bit)?1:0) + carry);
-        if (sum & 1) {
-            setBit(bit, 1);
-        }
-        carry = (sum >= 2);
+    vluint64_t carry = 0;
+    for (int i=0; i<words(); ++i) {
+        vluint64_t sum = (static_cast<vluint64_t>(lhs.valueWordExt(i))
+                          + static_cast<vluint64_t>(rhs.valueWordExt(i)) + carry);
+        m_value[i] = static_cast<uint32_t>(sum);
+        carry = sum >> VL_ULL(32);
     }
+    opCleanThis();
     return *this;
 }
 V3Number& V3Number::opSub(const V3Number& lhs, const V3Number& rhs) {
@@ -1908,9 +1946,12 @@ V3Number& V3Number::opAssign(const V3Number& lhs) {
             m_stringVal = lhs.m_stringVal;
         } else {
             // Also handles double as is just bits
-            for (int bit=0; bit<this->width(); bit++) {
-                setBit(bit, lhs.bitIs(bit));
+            for (int i=0; i<words(); ++i) {
+                m_value[i] = lhs.valueWordExt(i);
+                m_valueX[i] = lhs.valueXWordExt(i);
             }
+            m_value[words()-1] &= hiWordMask();
+            m_valueX[words()-1] &= hiWordMask();
         }
     }
     return *this;
@@ -32,6 +32,50 @@
 
 class AstNode;
 
+//============================================================================
+// Word storage for V3Number.  Like a std::vector<uint32_t>, but values up to
+// 128 bits (plus V3Number's spare word) are held inline, so the common
+// narrow constants and temporaries need no heap allocation.
+
+class V3NumberWords {
+    enum MiscConsts { INLINE_WORDS = 5 };
+    uint32_t    m_size;         // Number of words in use
+    uint32_t*   m_heapp;        // Heap storage when m_size > INLINE_WORDS, else NULL
+    uint32_t    m_inline[INLINE_WORDS];  // Inline storage
+    uint32_t* datap() { return m_heapp ? m_heapp : m_inline; }
+    const uint32_t* datap() const { return m_heapp ? m_heapp : m_inline; }
+public:
+    V3NumberWords() : m_size(0), m_heapp(NULL) {}
+    V3NumberWords(const V3NumberWords& rhs) : m_size(0), m_heapp(NULL) { *this = rhs; }
+    ~V3NumberWords() { delete[] m_heapp; }
+    V3NumberWords& operator=(const V3NumberWords& rhs) {
+        if (this == &rhs) return *this;
+        resize(rhs.m_size);
+        const uint32_t* fromp = rhs.datap();
+        uint32_t* top = datap();
+        for (uint32_t i = 0; i < m_size; ++i) top[i] = fromp[i];
+        return *this;
+    }
+    size_t size() const { return m_size; }
+    void resize(size_t size) {  // New words are zeroed
+        if (size > INLINE_WORDS && !m_heapp) {
+            uint32_t* newp = new uint32_t[size];
+            for (uint32_t i = 0; i < m_size; ++i) newp[i] = m_inline[i];
+            m_heapp = newp;
+        } else if (m_heapp && size > m_size) {
+            uint32_t* newp = new uint32_t[size];
+            for (uint32_t i = 0; i < m_size; ++i) newp[i] = m_heapp[i];
+            delete[] m_heapp;
+            m_heapp = newp;
+        }
+        uint32_t* datp = datap();
+        for (size_t i = m_size; i < size; ++i) datp[i] = 0;
+        m_size = size;
+    }
+    uint32_t& operator[](size_t word) { return datap()[word]; }
+    const uint32_t& operator[](size_t word) const { return datap()[word]; }
+};
+
 class V3Number {
     // Large 4-state number handling
     int         m_width;        // Width as specified/calculated.
@@ -43,8 +87,8 @@ class V3Number {
     bool        m_autoExtend:1; // True if SystemVerilog extend-to-any-width
     FileLine*   m_fileline;
     AstNode*    m_nodep;        // Parent node
-    std::vector<uint32_t> m_value;  // The Value, with bit 0 being in bit 0 of this vector (unless X/Z)
-    std::vector<uint32_t> m_valueX;  // Each bit is true if it's X or Z, 10=z, 11=x
+    V3NumberWords m_value;      // The Value, with bit 0 being in bit 0 of this vector (unless X/Z)
+    V3NumberWords m_valueX;     // Each bit is true if it's X or Z, 10=z, 11=x
     string              m_stringVal;  // If isString, the value of the string
     // METHODS
     V3Number& setSingleBits(char value);
@@ -125,6 +169,16 @@ private:
         if (bit>=m_width) return bitIsZ(m_width-1);
         return ( (~m_value[bit/32] & (1UL<<(bit&31)))
                  && (m_valueX[bit/32] & (1UL<<(bit&31))) ); }
+    uint32_t valueWordExt(int word) const {  // Value word, zero extended past width
+        if (word >= words()) return 0;
+        if (word == words()-1) return m_value[word] & hiWordMask();
+        return m_value[word];
+    }
+    uint32_t valueXWordExt(int word) const {  // X/Z word, zero extended past width
+        if (word >= words()) return 0;
+        if (word == words()-1) return m_valueX[word] & hiWordMask();
+        return m_valueX[word];
+    }
     uint32_t bitsValue(int lsb, int nbits) const {
         uint32_t v = 0;
         for (int bitn=0; bitn<nbits; bitn++) { v |= (bitIs1(lsb+bitn)<<bitn); }
@@ -831,6 +831,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
                     case 't': m_oLifePost = flag; break;
                     case 'u': m_oSubst = flag; break;
                     case 'v': m_oReloop = flag; break;
+                    case 'w': m_oPackBits = flag; break;
                     case 'x': m_oExpand = flag; break;
                     case 'y': m_oAcycSimp = flag; break;
                     case 'z': m_oLocalize = flag; break;
@@ -1155,6 +1156,9 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
             else if (!strcmp(sw, "-protect-key") && (i+1)<argc) {
                 shift; m_protectKey = argv[i];
             }
+            else if (!strcmp(sw, "-quiesce-min-cost") && (i+1)<argc) {
+                shift; m_quiesceMinCost = atoi(argv[i]);
+            }
             else if (!strcmp(sw, "-no-threads")) { m_threads = 0; }  // Undocumented until functional
             else if (!strcmp(sw, "-threads") && (i+1)<argc) {  // Undocumented until functional
                 shift; m_threads = atoi(argv[i]);
@@ -1517,6 +1521,7 @@ V3Options::V3Options() {
     m_outputSplit = 0;
     m_outputSplitCFuncs = 0;
     m_outputSplitCTrace = 0;
+    m_quiesceMinCost = 0;
     m_traceDepth = 0;
     m_traceMaxArray = 32;
     m_traceMaxWidth = 256;
@@ -1614,6 +1619,7 @@ void V3Options::optimize(int level) {
     m_oLife = flag;
     m_oLifePost = flag;
     m_oLocalize = flag;
+    m_oPackBits = flag;
     m_oReloop = flag;
     m_oReorder = flag;
     m_oSplit = flag;
@@ -206,6 +206,7 @@ class V3Options {
     int         m_outputSplitCFuncs;// main switch: --output-split-cfuncs
     int         m_outputSplitCTrace;// main switch: --output-split-ctrace
     int         m_pinsBv;       // main switch: --pins-bv
+    int         m_quiesceMinCost;  // main switch: --quiesce-min-cost
     VOptionBool m_skipIdentical;  // main switch: --skip-identical
     int         m_threads;      // main switch: --threads (0 == --no-threads)
     int         m_threadsMaxMTasks;  // main switch: --threads-max-mtasks
@@ -253,6 +254,7 @@ class V3Options {
     bool        m_oLife;        // main switch: -Ol: variable lifetime
     bool        m_oLifePost;    // main switch: -Ot: delayed assignment elimination
     bool        m_oLocalize;    // main switch: -Oz: convert temps to local variables
+    bool        m_oPackBits;    // main switch: -Ow: pack single bit signals into words
     bool        m_oInline;      // main switch: -Oi: module inlining
     bool        m_oReloop;      // main switch: -Ov: reform loops
     bool        m_oReorder;     // main switch: -Or: reorder assignments in blocks
@@ -381,6 +383,7 @@ class V3Options {
     int outputSplitCFuncs() const { return m_outputSplitCFuncs; }
     int outputSplitCTrace() const { return m_outputSplitCTrace; }
     int pinsBv() const { return m_pinsBv; }
+    int quiesceMinCost() const { return m_quiesceMinCost; }
     VOptionBool skipIdentical() const { return m_skipIdentical; }
     int threads() const { return m_threads; }
     int threadsMaxMTasks() const { return m_threadsMaxMTasks; }
@@ -450,6 +453,7 @@ class V3Options {
     bool oLife() const { return m_oLife; }
     bool oLifePost() const { return m_oLifePost; }
     bool oLocalize() const { return m_oLocalize; }
+    bool oPackBits() const { return m_oPackBits; }
     bool oInline() const { return m_oInline; }
     bool oReloop() const { return m_oReloop; }
     bool oReorder() const { return m_oReorder; }
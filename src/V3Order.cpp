@@ -66,6 +66,12 @@
 //
 //   Rank the graph starting at INPUTS (see V3Graph)
 //
+//   Find combo loops which may converge in place
+//      For each strongly connected component of only combo logic in one scope
+//         Move all of its logic as one unit, in a loop of its own that
+//         repeats until the variables on its cut edges stop changing
+//         These variables then need no change detection in _eval
+//
 //   Visit the graph's logic vertices in ranked order
 //      For all logic vertices with all inputs already ordered
 //         Make ordered block for this module
@@ -87,6 +93,7 @@
 #include "V3Global.h"
 #include "V3Graph.h"
 #include "V3GraphStream.h"
+#include "V3InstrCount.h"
 #include "V3List.h"
 #include "V3Partition.h"
 #include "V3PartitionGraph.h"
@@ -102,6 +109,7 @@
 #include <iomanip>
 #include <map>
 #include <memory>
+#include <set>
 #include <sstream>
 #include <vector>
 #include VL_INCLUDE_UNORDERED_MAP
@@ -422,6 +430,82 @@ public:
     bool isClkAss() { return m_clkAss; }
 };
 
+//######################################################################
+// Find the variables a block of initial/settle logic reads and writes,
+// and whether it has side effects that must stay in order with others
+
+class OrderTouchVisitor : public AstNVisitor {
+public:
+    typedef std::vector<std::pair<AstVarScope*,bool> > Touches;
+private:
+    // STATE
+    Touches     m_touches;      // Variables referenced, and if written
+    bool        m_impure;       // Has output, DPI or other side effects
+    std::set<const AstCFunc*> m_funcsDone;  // Called functions already searched
+
+    // METHODS
+    VL_DEBUG_FUNC;  // Declare debug()
+
+    // VISITORS
+    virtual void visit(AstNodeVarRef* nodep) {
+        if (nodep->varScopep()) {
+            m_touches.push_back(make_pair(nodep->varScopep(), nodep->lvalue()));
+        }
+    }
+    virtual void visit(AstCCall* nodep) {
+        iterateChildren(nodep);
+        AstCFunc* funcp = nodep->funcp();
+        if (funcp->dpiImport() || funcp->dpiExport()) m_impure = true;
+        // Also anything the function touches
+        if (m_funcsDone.insert(funcp).second) iterateChildren(funcp);
+    }
+    // Random state is shared by the whole context; draw it from one
+    // thread so the sequence is in the same order every run
+    virtual void visit(AstRand* nodep) { m_impure = true; }
+    // Textual C code, including user $c, may do anything
+    virtual void visit(AstCStmt* nodep) { m_impure = true; }
+    virtual void visit(AstCMath* nodep) { m_impure = true; }
+    virtual void visit(AstUCStmt* nodep) { m_impure = true; }
+    virtual void visit(AstUCFunc* nodep) { m_impure = true; }
+    virtual void visit(AstReadMem* nodep) {
+        // Loading a memory only writes the memory; fine on any thread
+        iterateChildren(nodep);
+    }
+    virtual void visit(AstNode* nodep) {
+        if (!nodep->isPure() || nodep->isOutputter()) m_impure = true;
+        iterateChildren(nodep);
+    }
+public:
+    // CONSTRUCTORS
+    explicit OrderTouchVisitor(AstNode* nodep) {
+        m_impure = false;
+        iterate(nodep);
+    }
+    virtual ~OrderTouchVisitor() {}
+    // METHODS
+    const Touches& touches() const { return m_touches; }
+    bool impure() const { return m_impure; }
+};
+
+//######################################################################
+// Combo loops converged in place
+
+class OrderLocalLoop {
+    // Strongly connected component of combo logic, moved as one unit
+    // and repeated until the variables on its cut edges are stable
+public:
+    typedef std::vector<const OrderLogicVertex*> LogicVec;
+    typedef std::vector<const OrderVarStdVertex*> VarVec;
+    AstScope*   m_scopep;       // Scope all logic is under
+    LogicVec    m_logicps;      // Logic in the loop, in graph order
+    VarVec      m_varps;        // Variables in the loop
+    std::vector<AstVarScope*> m_cutVscps;  // Variables on cut edges, compared for convergence
+    OrderLocalLoop() : m_scopep(NULL) {}
+};
+
+// Vertices of loops that are moved as one unit, mapped to the loop's first logic
+typedef vl_unordered_map<const V3GraphVertex*, const OrderLogicVertex*> OrderLoopLeaders;
+
 //######################################################################
 // ProcessMoveBuildGraph
 
@@ -469,15 +553,19 @@ private:
     MoveVertexMaker* m_vxMakerp;        // Factory class for T_MoveVertex's
     Logic2Move       m_logic2move;      // Map Logic to Vertex
     Var2Move         m_var2move;        // Map Vars to Vertex
+    const OrderLoopLeaders* m_leadersp;  // Loops to move as one vertex, or NULL
+    vl_unordered_set<const V3GraphVertex*> m_loopVarsDone;  // Loop variables already searched
 
 public:
     // CONSTRUCTORS
     ProcessMoveBuildGraph(const V3Graph* logicGraphp,  // Input graph of OrderLogicVertex etc.
                           V3Graph* outGraphp,  // Output graph of T_MoveVertex's
-                          MoveVertexMaker* vxMakerp)
+                          MoveVertexMaker* vxMakerp,
+                          const OrderLoopLeaders* leadersp = NULL)
         : m_graphp(logicGraphp),
           m_outGraphp(outGraphp),
-          m_vxMakerp(vxMakerp) {}
+          m_vxMakerp(vxMakerp),
+          m_leadersp(leadersp) {}
     virtual ~ProcessMoveBuildGraph() {}
 
     // METHODS
@@ -493,11 +581,20 @@ public:
         //      forward in the context of the same domain.  Unless we
         //      already created that pair, in which case, we've already
         //      done the forward search, so stop.
+        //  - Logic of a local loop shares the T_MoveVertex of the loop's
+        //    first logic, and its variables are searched through as if
+        //    the loop were one logic vertex.
 
         // For each logic node, make a T_MoveVertex
         for (V3GraphVertex* itp = m_graphp->verticesBeginp(); itp;
              itp=itp->verticesNextp()) {
             if (OrderLogicVertex* lvertexp = dynamic_cast<OrderLogicVertex*>(itp)) {
+                const OrderLogicVertex* leaderp = loopLeaderp(lvertexp);
+                if (leaderp && leaderp != lvertexp) {
+                    // Later logic of loop; leader is earlier in graph order
+                    m_logic2move[lvertexp] = m_logic2move[leaderp];
+                    continue;
+                }
                 T_MoveVertex* moveVxp =
                     m_vxMakerp->makeVertexp(lvertexp, NULL, lvertexp->scopep(),
                                             lvertexp->domainp());
@@ -520,6 +617,11 @@ public:
     }
 
 private:
+    const OrderLogicVertex* loopLeaderp(const V3GraphVertex* vxp) const {
+        if (!m_leadersp) return NULL;
+        OrderLoopLeaders::const_iterator it = m_leadersp->find(vxp);
+        return (it != m_leadersp->end()) ? it->second : NULL;
+    }
     // Return true if moveVxp has downstream dependencies
     bool iterate(T_MoveVertex* moveVxp, const V3GraphVertex* origVxp,
                  const AstSenTree* domainp) {
@@ -536,6 +638,8 @@ private:
 
                 // Do not construct dependencies across exclusive domains.
                 if (domainsExclusive(domainp, toLVertexp->domainp())) continue;
+                // Nor within a local loop
+                if (m_logic2move[toLVertexp] == moveVxp) continue;
 
                 // Path from vertexp to a logic vertex; new edge.
                 // Note we use the last edge's weight, not some function of
@@ -547,6 +651,17 @@ private:
                 // This is an OrderVarVertex or other vertex representing
                 // data. (Could be var, settle, or input type vertex.)
                 const V3GraphVertex* nonLogicVxp = edgep->top();
+                if (const OrderLogicVertex* leaderp = loopLeaderp(nonLogicVxp)) {
+                    if (m_logic2move[leaderp] == moveVxp) {
+                        // Variable inside a local loop; what reads it
+                        // depends on the loop as a whole
+                        if (m_loopVarsDone.insert(nonLogicVxp).second) {
+                            iterate(moveVxp, nonLogicVxp, domainp);
+                        }
+                        madeDeps = true;
+                        continue;
+                    }
+                }
                 VxDomPair key(nonLogicVxp, domainp);
                 if (!m_var2move[key]) {
                     const OrderEitherVertex* eithp =
@@ -715,6 +830,10 @@ private:
     int                         m_pomNewStmts;  // Statements in function being created
     V3Graph                     m_pomGraph;     // Graph of logic elements to move
     V3List<OrderMoveVertex*>    m_pomWaiting;   // List of nodes needing inputs to become ready
+    typedef std::map<uint32_t,OrderLocalLoop> LocalLoops;
+    LocalLoops                  m_localLoops;   // Combo loops to converge in place, by graph color
+    OrderLoopLeaders            m_loopLeaders;  // Vertices of each local loop -> its first logic
+    int                         m_localLoopNum; // Number of local loops emitted, for naming
 protected:
     friend class OrderMoveDomScope;
     V3List<OrderMoveDomScope*>  m_pomReadyDomScope;     // List of ready domain/scope pairs, by loopId
@@ -723,6 +842,8 @@ protected:
 private:
     // STATS
     VDouble0 m_statCut[OrderVEdgeType::_ENUM_END];  // Count of each edge type cut
+    VDouble0 m_statLocalLoops;  // Count of loops converged in place
+    VDouble0 m_statInitialThreads;  // Count of threads running initial/settle logic
 
     // TYPES
     enum VarUsage { VU_NONE=0, VU_CON=1, VU_GEN=2 };
@@ -772,6 +893,7 @@ private:
     void processDomains();
     void processDomainsIterate(OrderEitherVertex* vertexp);
     void processEdgeReport();
+    void processLocalLoops();
 
     // processMove* routines schedule serial execution
     void processMove();
@@ -783,6 +905,9 @@ private:
     void processMoveOne(OrderMoveVertex* vertexp, OrderMoveDomScope* domScopep, int level);
     AstActive* processMoveOneLogic(const OrderLogicVertex* lvertexp,
                                    AstCFunc*& newFuncpr, int& newStmtsr);
+    AstActive* processMoveLoop(const OrderLocalLoop& loop,
+                               AstCFunc*& newFuncpr, int& newStmtsr);
+    AstVarScope* newLoopVarScope(AstNodeModule* modp, AstScope* scopep, AstVar* varp);
 
     // processMTask* routines schedule threaded execution
     struct MTaskState {
@@ -794,7 +919,9 @@ private:
     };
     void processMTasks();
     typedef enum {LOGIC_INITIAL, LOGIC_SETTLE} InitialLogicE;
+    typedef std::vector<OrderLogicVertex*> InitialLogics;
     void processMTasksInitial(InitialLogicE logic_type);
+    bool processMTasksInitialThreads(InitialLogicE logic_type, const InitialLogics& logics);
 
     string cfuncName(AstNodeModule* modp, AstSenTree* domainp,
                      AstScope* scopep, AstNode* forWhatp) {
@@ -1258,6 +1385,7 @@ public:
         m_logicVxp = NULL;
         m_pomNewFuncp = NULL;
         m_pomNewStmts = 0;
+        m_localLoopNum = 0;
         if (debug()) m_graph.debug(5);  // 3 is default if global debug; we want acyc debugging
     }
     virtual ~OrderVisitor() {
@@ -1268,6 +1396,10 @@ public:
                 V3Stats::addStat(string("Order, cut, ")+OrderVEdgeType(type).ascii(), count);
             }
         }
+        V3Stats::addStat("Order, local loops", m_statLocalLoops);
+        if (v3Global.opt.mtasks()) {
+            V3Stats::addStat("Order, initial/settle threads", m_statInitialThreads);
+        }
         // Destruction
         for (std::deque<OrderUser*>::iterator it=m_orderUserps.begin();
              it != m_orderUserps.end(); ++it) {
@@ -1598,6 +1730,77 @@ void OrderVisitor::processDomainsIterate(OrderEitherVertex* vertexp) {
     }
 }
 
+//######################################################################
+// OrderVisitor - Local loops
+
+void OrderVisitor::processLocalLoops() {
+    // Each strongly connected component of the graph has its own color.
+    // If a component is all combo logic in one scope, with only simple
+    // variables cut, it can be moved as one unit and repeated until its
+    // cut variables are stable.  This converges the loop in place, instead
+    // of re-evaluating the whole model until _change_request is clear.
+    std::set<uint32_t> badColors;
+    for (V3GraphVertex* itp = m_graph.verticesBeginp(); itp; itp=itp->verticesNextp()) {
+        uint32_t color = itp->color();
+        if (!color) continue;
+        OrderLocalLoop& loop = m_localLoops[color];
+        bool ok = true;
+        if (const OrderLogicVertex* lvertexp = dynamic_cast<OrderLogicVertex*>(itp)) {
+            if (lvertexp->domainp() != m_comboDomainp
+                || (loop.m_scopep && loop.m_scopep != lvertexp->scopep())) {
+                ok = false;
+            }
+            loop.m_scopep = lvertexp->scopep();
+            loop.m_logicps.push_back(lvertexp);
+        } else if (const OrderVarStdVertex* vvertexp = dynamic_cast<OrderVarStdVertex*>(itp)) {
+            AstVarScope* vscp = vvertexp->varScp();
+            if (vscp->isCircular()) {
+                // Clocks need a full evaluation to trigger their logic;
+                // public signals may also change from outside the model
+                const AstNodeDType* dtypep = vscp->varp()->dtypeSkipRefp();
+                if (vvertexp->isClock() || vscp->varp()->isSigPublic()
+                    || !(VN_IS(dtypep, BasicDType) || VN_IS(dtypep, PackArrayDType))) {
+                    ok = false;
+                }
+                loop.m_cutVscps.push_back(vscp);
+            }
+            loop.m_varps.push_back(vvertexp);
+        } else {
+            ok = false;
+        }
+        for (V3GraphEdge* edgep = itp->outBeginp(); edgep; edgep=edgep->outNextp()) {
+            if (edgep->weight()==0 && edgep->top()->color() != color) ok = false;
+        }
+        if (!ok) badColors.insert(color);
+    }
+    for (LocalLoops::iterator it = m_localLoops.begin(); it != m_localLoops.end(); ) {
+        OrderLocalLoop& loop = it->second;
+        if (badColors.find(it->first) != badColors.end()
+            || loop.m_logicps.empty() || loop.m_cutVscps.empty()) {
+            m_localLoops.erase(it++);
+            continue;
+        }
+        UINFO(4,"  Local loop c"<<it->first<<" logic="<<loop.m_logicps.size()
+              <<" cut="<<loop.m_cutVscps.size()<<endl);
+        ++m_statLocalLoops;
+        // Converged here, so no longer needs change detection
+        for (std::vector<AstVarScope*>::iterator vit = loop.m_cutVscps.begin();
+             vit != loop.m_cutVscps.end(); ++vit) {
+            (*vit)->circular(false);
+        }
+        const OrderLogicVertex* leaderp = loop.m_logicps.front();
+        for (OrderLocalLoop::LogicVec::iterator lit = loop.m_logicps.begin();
+             lit != loop.m_logicps.end(); ++lit) {
+            m_loopLeaders[*lit] = leaderp;
+        }
+        for (OrderLocalLoop::VarVec::iterator vit = loop.m_varps.begin();
+             vit != loop.m_varps.end(); ++vit) {
+            m_loopLeaders[*vit] = leaderp;
+        }
+        ++it;
+    }
+}
+
 //######################################################################
 // OrderVisitor - Move graph construction
 
@@ -1648,7 +1851,7 @@ void OrderVisitor::processMoveBuildGraph() {
 
     OrderMoveVertexMaker createOrderMoveVertex(&m_pomGraph, &m_pomWaiting);
     ProcessMoveBuildGraph<OrderMoveVertex> serialPMBG(
-        &m_graph, &m_pomGraph, &createOrderMoveVertex);
+        &m_graph, &m_pomGraph, &createOrderMoveVertex, &m_loopLeaders);
     serialPMBG.build();
 }
 
@@ -1764,8 +1967,15 @@ void OrderVisitor::processMoveOne(OrderMoveVertex* vertexp,
     const AstScope* scopep = lvertexp->scopep();
     UINFO(5,"    POSmove l"<<std::setw(3)<<level<<" d="<<cvtToHex(lvertexp->domainp())
           <<" s="<<cvtToHex(scopep)<<" "<<lvertexp<<endl);
-    AstActive* newActivep = processMoveOneLogic(lvertexp, m_pomNewFuncp/*ref*/,
-                                                m_pomNewStmts/*ref*/);
+    AstActive* newActivep;
+    LocalLoops::const_iterator loopIt = m_localLoops.find(lvertexp->color());
+    if (lvertexp->color() && loopIt != m_localLoops.end()) {
+        newActivep = processMoveLoop(loopIt->second, m_pomNewFuncp/*ref*/,
+                                     m_pomNewStmts/*ref*/);
+    } else {
+        newActivep = processMoveOneLogic(lvertexp, m_pomNewFuncp/*ref*/,
+                                         m_pomNewStmts/*ref*/);
+    }
     if (newActivep) m_scopetopp->addActivep(newActivep);
     processMoveDoneOne(vertexp);
 }
@@ -1824,13 +2034,97 @@ AstActive* OrderVisitor::processMoveOneLogic(const OrderLogicVertex* lvertexp,
     return activep;
 }
 
+AstVarScope* OrderVisitor::newLoopVarScope(AstNodeModule* modp, AstScope* scopep,
+                                           AstVar* varp) {
+    modp->addStmtp(varp);
+    AstVarScope* vscp = new AstVarScope(varp->fileline(), scopep, varp);
+    scopep->addVarp(vscp);
+    return vscp;
+}
+
+AstActive* OrderVisitor::processMoveLoop(const OrderLocalLoop& loop,
+                                         AstCFunc*& newFuncpr, int& newStmtsr) {
+    // Move the first logic normally, so it makes or borrows the function,
+    // then take all the loop's logic into a loop:
+    //   __Vloop__change = 1; __Vloop__count = 0;
+    //   while (__Vloop__change) {
+    //       if (++__Vloop__count > converge_limit) fatal;
+    //       __Vloop__<cut> = <cut>; ...
+    //       <logic> ...
+    //       __Vloop__change = (<cut> != __Vloop__<cut>) | ...;
+    //   }
+    const OrderLogicVertex* firstp = loop.m_logicps.front();
+    AstActive* activep = processMoveOneLogic(firstp, newFuncpr/*ref*/, newStmtsr/*ref*/);
+    AstScope* scopep = loop.m_scopep;
+    AstNodeModule* modp = VN_CAST(scopep->user1p(), NodeModule);  // Stashed by visitor func
+    UASSERT(modp, "NULL");
+    FileLine* fl = firstp->nodep()->fileline();
+    string prefix = "__Vloop"+cvtToStr(m_localLoopNum++)+"__";
+
+    AstNode* logicsp = NULL;
+    for (OrderLocalLoop::LogicVec::const_iterator it = loop.m_logicps.begin();
+         it != loop.m_logicps.end(); ++it) {
+        AstNode* nodep = (*it)->nodep()->unlinkFrBack();
+        logicsp = logicsp ? logicsp->addNext(nodep) : nodep;
+        if (v3Global.opt.outputSplitCFuncs() && *it != firstp) {
+            EmitCBaseCounterVisitor visitor(nodep);
+            newStmtsr += visitor.count();
+        }
+    }
+
+    AstVarScope* changeVscp = newLoopVarScope(
+        modp, scopep, new AstVar(fl, AstVarType::BLOCKTEMP, prefix+"change",
+                                 VFlagBitPacked(), 1));
+    AstVarScope* countVscp = newLoopVarScope(
+        modp, scopep, new AstVar(fl, AstVarType::BLOCKTEMP, prefix+"count",
+                                 VFlagBitPacked(), 32));
+    AstNode* savesp = NULL;
+    AstNode* changep = NULL;
+    for (std::vector<AstVarScope*>::const_iterator it = loop.m_cutVscps.begin();
+         it != loop.m_cutVscps.end(); ++it) {
+        AstVarScope* vscp = *it;
+        AstVarScope* lastVscp = newLoopVarScope(
+            modp, scopep, new AstVar(fl, AstVarType::BLOCKTEMP,
+                                     prefix+vscp->varp()->name(), vscp->varp()));
+        AstNode* savep = new AstAssign(fl, new AstVarRef(fl, lastVscp, true),
+                                       new AstVarRef(fl, vscp, false));
+        savesp = savesp ? savesp->addNext(savep) : savep;
+        AstNode* neqp = new AstNeq(fl, new AstVarRef(fl, vscp, false),
+                                   new AstVarRef(fl, lastVscp, false));
+        changep = changep ? new AstOr(fl, changep, neqp) : neqp;
+    }
+
+    string fatal = ("VL_FATAL_MT(\""
+                    +V3OutFormatter::quoteNameControls(
+                        EmitCBaseVisitor::protect(fl->filename()))
+                    +"\", "+cvtToStr(fl->lineno())+", \"\", "
+                    +"\"Verilated model didn't converge\\n"
+                    +"- See DIDNOTCONVERGE in the Verilator manual\");\n");
+    AstNode* bodysp = new AstAssign(fl, new AstVarRef(fl, countVscp, true),
+                                    new AstAdd(fl, new AstVarRef(fl, countVscp, false),
+                                               new AstConst(fl, 1)));
+    bodysp->addNext(new AstIf(fl, new AstGt(fl, new AstVarRef(fl, countVscp, false),
+                                            new AstConst(fl, v3Global.opt.convergeLimit())),
+                              new AstCStmt(fl, fatal), NULL));
+    bodysp->addNext(savesp);
+    bodysp->addNext(logicsp);
+    bodysp->addNext(new AstAssign(fl, new AstVarRef(fl, changeVscp, true), changep));
+
+    AstNode* stmtsp = new AstAssign(fl, new AstVarRef(fl, changeVscp, true),
+                                    new AstConst(fl, AstConst::LogicTrue()));
+    stmtsp->addNext(new AstAssign(fl, new AstVarRef(fl, countVscp, true),
+                                  new AstConst(fl, 0)));
+    stmtsp->addNext(new AstWhile(fl, new AstVarRef(fl, changeVscp, false), bodysp));
+    newFuncpr->addStmtsp(stmtsp);
+    return activep;
+}
+
 void OrderVisitor::processMTasksInitial(InitialLogicE logic_type) {
     // Emit initial/settle logic. Initial blocks won't be part of the
-    // mtask partition, aren't eligible for parallelism.
+    // mtask partition; independent groups of them may instead be run
+    // across the thread pool.
     //
-    int initStmts = 0;
-    AstCFunc* initCFunc = NULL;
-    AstScope* lastScopep = NULL;
+    InitialLogics logics;
     for (V3GraphVertex* initVxp = m_graph.verticesBeginp();
          initVxp; initVxp = initVxp->verticesNextp()) {
         OrderLogicVertex* initp = dynamic_cast<OrderLogicVertex*>(initVxp);
@@ -1839,6 +2133,15 @@ void OrderVisitor::processMTasksInitial(InitialLogicE logic_type) {
             && !initp->domainp()->hasInitial()) continue;
         if ((logic_type == LOGIC_SETTLE)
             && !initp->domainp()->hasSettle()) continue;
+        logics.push_back(initp);
+    }
+    if (processMTasksInitialThreads(logic_type, logics)) return;
+
+    int initStmts = 0;
+    AstCFunc* initCFunc = NULL;
+    AstScope* lastScopep = NULL;
+    for (InitialLogics::iterator it = logics.begin(); it != logics.end(); ++it) {
+        OrderLogicVertex* initp = *it;
         if (initp->scopep() != lastScopep) {
             // Start new cfunc, don't let the cfunc cross scopes
             initCFunc = NULL;
@@ -1849,6 +2152,159 @@ void OrderVisitor::processMTasksInitial(InitialLogicE logic_type) {
     }
 }
 
+bool OrderVisitor::processMTasksInitialThreads(InitialLogicE logic_type,
+                                               const InitialLogics& logics) {
+    // Logic sharing no variable that either writes can run concurrently.
+    // Group logic by the variables it writes, keep all logic with side
+    // effects in one group so it stays in order, then spread the groups
+    // over one function per thread.  The calling thread runs the first
+    // function (with any side effects), the thread pool runs the rest:
+    //   __Vm_init_even = !__Vm_init_even;
+    //   __Vm_threadPoolp->workerp(0)->addTask(_eval_settle__thread1, ...);
+    //   ...
+    //   _eval_settle__thread0(...);
+    //   __Vm_mt_init.waitUntilUpstreamDone(__Vm_init_even);
+    int threads = v3Global.opt.threads();
+    if (logics.size() < 2) return false;
+
+    // Union-find of logic index to its group
+    std::vector<size_t> groupOf (logics.size());
+    for (size_t i = 0; i < logics.size(); ++i) groupOf[i] = i;
+    struct Group {
+        static size_t find(std::vector<size_t>& groupOf, size_t i) {
+            while (groupOf[i] != i) i = groupOf[i] = groupOf[groupOf[i]];
+            return i;
+        }
+        static void merge(std::vector<size_t>& groupOf, size_t a, size_t b) {
+            a = find(groupOf, a);
+            b = find(groupOf, b);
+            if (a != b) groupOf[std::max(a, b)] = std::min(a, b);
+        }
+    };
+    typedef std::map<const AstVarScope*, std::vector<size_t> > VarLogics;
+    VarLogics varLogics;  // Logic referencing each variable
+    std::set<const AstVarScope*> written;  // Variables written by any logic
+    std::vector<uint32_t> costs (logics.size());
+    size_t impureIdx = logics.size();  // First logic with side effects
+    for (size_t i = 0; i < logics.size(); ++i) {
+        AstNode* nodep = logics[i]->nodep();
+        OrderTouchVisitor touchVisitor (nodep);
+        for (OrderTouchVisitor::Touches::const_iterator it = touchVisitor.touches().begin();
+             it != touchVisitor.touches().end(); ++it) {
+            varLogics[it->first].push_back(i);
+            if (it->second) written.insert(it->first);
+        }
+        if (touchVisitor.impure()) {
+            if (impureIdx == logics.size()) impureIdx = i;
+            Group::merge(groupOf, impureIdx, i);
+        }
+        costs[i] = V3InstrCount::count(nodep, false) + 1;
+    }
+    for (VarLogics::iterator it = varLogics.begin(); it != varLogics.end(); ++it) {
+        if (written.find(it->first) == written.end()) continue;  // Only read
+        for (std::vector<size_t>::iterator lit = it->second.begin();
+             lit != it->second.end(); ++lit) {
+            Group::merge(groupOf, it->second.front(), *lit);
+        }
+    }
+
+    // Largest groups first, each to the least loaded thread
+    typedef std::map<size_t, uint64_t> GroupCosts;
+    GroupCosts groupCosts;
+    for (size_t i = 0; i < logics.size(); ++i) {
+        groupCosts[Group::find(groupOf, i)] += costs[i];
+    }
+    if (groupCosts.size() < 2) return false;
+    std::vector<std::pair<uint64_t, size_t> > bySize;
+    for (GroupCosts::iterator it = groupCosts.begin(); it != groupCosts.end(); ++it) {
+        bySize.push_back(make_pair(it->second, it->first));
+    }
+    std::stable_sort(bySize.begin(), bySize.end(),
+                     std::greater<std::pair<uint64_t, size_t> >());
+    std::vector<uint64_t> threadCosts (threads);
+    std::map<size_t, int> threadOf;  // Group -> thread
+    if (impureIdx != logics.size()) {
+        size_t group = Group::find(groupOf, impureIdx);
+        threadOf[group] = 0;
+        threadCosts[0] += groupCosts[group];
+    }
+    for (size_t i = 0; i < bySize.size(); ++i) {
+        size_t group = bySize[i].second;
+        if (threadOf.find(group) != threadOf.end()) continue;
+        int best = 0;
+        for (int t = 1; t < threads; ++t) {
+            if (threadCosts[t] < threadCosts[best]) best = t;
+        }
+        threadOf[group] = best;
+        threadCosts[best] += groupCosts[group];
+    }
+    UINFO(4,"  Initial/settle groups="<<groupCosts.size()<<" on "<<threads<<" threads\n");
+    m_statInitialThreads += threads;
+
+    // Function for each thread
+    FileLine* fl = logics.front()->nodep()->fileline();
+    AstSenTree* domainp = logics.front()->domainp();
+    string prefix = (logic_type == LOGIC_INITIAL) ? "_eval_initial__thread" : "_eval_settle__thread";
+    std::vector<AstCFunc*> threadFuncps;
+    for (int t = 0; t < threads; ++t) {
+        AstCFunc* funcp = new AstCFunc(fl, prefix+cvtToStr(t), m_scopetopp);
+        funcp->argTypes("bool even_cycle, void* symtab");
+        funcp->isStatic(true);
+        funcp->slow(true);
+        funcp->dontCombine(true);
+        funcp->addInitsp(new AstCStmt(fl, EmitCBaseVisitor::symClassVar()
+                                      +" = static_cast<"+EmitCBaseVisitor::symClassName()
+                                      +"*>(symtab);\n"));
+        funcp->addInitsp(new AstCStmt(fl, EmitCBaseVisitor::symTopAssign()+"\n"));
+        if (t) funcp->addStmtsp(new AstCStmt(fl, "VerilatedContextGuard __Vcontext_guard("
+                                             "vlSymsp->__Vm_contextp);\n"));
+        m_scopetopp->addActivep(funcp);
+        threadFuncps.push_back(funcp);
+    }
+
+    // Move logic, in order, into each thread's functions
+    std::vector<AstCFunc*> cfuncps (threads);
+    std::vector<int> stmts (threads);
+    std::vector<AstScope*> lastScopeps (threads);
+    for (size_t i = 0; i < logics.size(); ++i) {
+        OrderLogicVertex* initp = logics[i];
+        int t = threadOf[Group::find(groupOf, i)];
+        if (initp->scopep() != lastScopeps[t]) {
+            // Start new cfunc, don't let the cfunc cross scopes
+            cfuncps[t] = NULL;
+            lastScopeps[t] = initp->scopep();
+        }
+        AstActive* newActivep = processMoveOneLogic(initp, cfuncps[t]/*ref*/, stmts[t]/*ref*/);
+        if (newActivep) {
+            threadFuncps[t]->addStmtsp(newActivep->stmtsp()->unlinkFrBackWithNext());
+            pushDeletep(newActivep); VL_DANGLING(newActivep);
+        }
+    }
+    for (int t = 1; t < threads; ++t) {
+        threadFuncps[t]->addStmtsp(
+            new AstCStmt(fl, "Verilated::endOfThreadMTask(vlSymsp->__Vm_evalMsgQp);\n"));
+        threadFuncps[t]->addStmtsp(
+            new AstCStmt(fl, "vlTOPp->__Vm_mt_init.signalUpstreamDone(even_cycle);\n"));
+    }
+
+    // Start the threads
+    AstActive* activep = new AstActive(fl, prefix, domainp);
+    activep->addStmtsp(new AstCStmt(fl, "vlTOPp->__Vm_init_even = !vlTOPp->__Vm_init_even;\n"));
+    for (int t = 1; t < threads; ++t) {
+        activep->addStmtsp(new AstCStmt(fl, "vlTOPp->__Vm_threadPoolp->workerp("
+                                        +cvtToStr(t - 1)+")->addTask("
+                                        +threadFuncps[t]->nameProtect()
+                                        +", vlTOPp->__Vm_init_even, vlSymsp);\n"));
+    }
+    AstCCall* callp = new AstCCall(fl, threadFuncps[0]);
+    callp->argTypes("vlTOPp->__Vm_init_even, vlSymsp");
+    activep->addStmtsp(callp);
+    activep->addStmtsp(new AstCStmt(fl, "vlTOPp->__Vm_mt_init.waitUntilUpstreamDone("
+                                    "vlTOPp->__Vm_init_even);\n"));
+    m_scopetopp->addActivep(activep);
+    return true;
+}
+
 void OrderVisitor::processMTasks() {
     // For nondeterminism debug:
     V3Partition::hashGraphDebug(&m_graph, "V3Order's m_graph");
@@ -2029,6 +2485,9 @@ void OrderVisitor::process() {
     if (debug() && v3Global.opt.dumpTree()) processEdgeReport();
 
     if (!v3Global.opt.mtasks()) {
+        UINFO(2,"  Local Loops...\n");
+        processLocalLoops();  // must be after processDomains
+
         UINFO(2,"  Construct Move Graph...\n");
         processMoveBuildGraph();
         if (debug()>=4) m_pomGraph.dumpDotFilePrefixed("ordermv_start");  // Different prefix (ordermv) as it's not the same graph
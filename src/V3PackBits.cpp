@@ -0,0 +1,437 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Pack single-bit signals into words
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2003-2019 by Wilson Snyder.  This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+//
+// Verilator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+//*************************************************************************
+// V3PackBits's Transformations:
+//
+// After ordering, so merging variables can't create false dependencies:
+//
+// Find single-bit unsigned variables that are assigned exactly once
+//      outside slow code, by a top level ASSIGN in a CFunc
+// Group them by scope, function, and structure of the assigned
+//      expression, with other single-bit variables abstracted
+//      ie. assign a0 = b0 & c[0] | en;  assign a1 = b1 & c[1] | en;
+// Within each function, hoist the assignments of a group together
+//      where nothing between depends on, or changes the inputs of, them
+// Replace each such run with one assignment to a new packed word:
+//      ASSIGN(__Vpack, CONCAT(expr1, expr0))
+// Replace every other reference with a SEL of the word.
+//
+// V3Const then merges the CONCATs of like operations into single wide
+// operations, ie. {b1 & c[1], b0 & c[0]} -> {b1, b0} & c[1:0], so
+// one bitwise instruction evaluates the whole group.
+//
+//*************************************************************************
+
+#include "config_build.h"
+#include "verilatedos.h"
+
+#include "V3Global.h"
+#include "V3PackBits.h"
+#include "V3Stats.h"
+#include "V3Ast.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdarg>
+#include <map>
+#include <set>
+#include <vector>
+
+//######################################################################
+
+class PackBitsBaseVisitor : public AstNVisitor {
+public:
+    // TYPES
+    typedef std::set<AstVarScope*> VarScopeSet;
+    typedef std::vector<AstVarScope*> VarScopeList;
+
+    // METHODS
+    VL_DEBUG_FUNC;  // Declare debug()
+};
+
+//######################################################################
+// Gather the variables a statement reads and writes
+
+class PackBitsRefsVisitor : public PackBitsBaseVisitor {
+private:
+    // STATE
+    VarScopeSet*        m_readsp;       // Variables read
+    VarScopeSet*        m_writesp;      // Variables written
+    bool                m_impure;       // Calls or side effects; may touch anything
+
+    // VISITORS
+    virtual void visit(AstVarRef* nodep) {
+        if (nodep->lvalue()) m_writesp->insert(nodep->varScopep());
+        else m_readsp->insert(nodep->varScopep());
+    }
+    virtual void visit(AstCCall* nodep) { m_impure = true; }
+    virtual void visit(AstCStmt* nodep) { m_impure = true; }
+    virtual void visit(AstCMath* nodep) { m_impure = true; }
+    virtual void visit(AstUCStmt* nodep) { m_impure = true; }
+    virtual void visit(AstUCFunc* nodep) { m_impure = true; }
+    virtual void visit(AstNode* nodep) {
+        if (!nodep->isPure()) m_impure = true;
+        iterateChildren(nodep);
+    }
+
+public:
+    // CONSTRUCTORS
+    PackBitsRefsVisitor(AstNode* nodep, VarScopeSet* readsp, VarScopeSet* writesp) {
+        m_readsp = readsp;
+        m_writesp = writesp;
+        m_impure = false;
+        iterate(nodep);
+    }
+    virtual ~PackBitsRefsVisitor() {}
+    bool impure() const { return m_impure; }
+};
+
+//######################################################################
+// Pack bits, as a visitor of each AstNode
+
+class PackBitsVisitor : public PackBitsBaseVisitor {
+private:
+    // NODE STATE
+    // Entire netlist:
+    //  AstVarScope::user1()    -> bool. True if can't be packed
+    //  AstVarScope::user2p()   -> AstAssign*. The only non-slow assignment to the variable
+    //  AstVarScope::user3p()   -> AstCFunc*. Function containing user2p()
+    //  AstVarScope::user4p()   -> AstVarScope*. Word the variable was packed into
+    //  AstVarScope::user5()    -> int. Bit of user4p() holding the variable
+    AstUser1InUse       m_inuser1;
+    AstUser2InUse       m_inuser2;
+    AstUser3InUse       m_inuser3;
+    AstUser4InUse       m_inuser4;
+    AstUser5InUse       m_inuser5;
+
+    // TYPES
+    typedef std::map<string, VarScopeList> GroupMap;  // Sorted for stable word numbering
+    typedef std::map<AstVarScope*, VarScopeList> WordMap;
+
+    // CONSTANTS
+    enum MiscConsts {
+        PACK_MIN = 4,           // Fewest bits worth a word
+        PACK_MAX = 64,          // Most bits in a word
+        SHAPE_MAX_NODES = 32    // Larger expressions aren't glue logic
+    };
+
+    // STATE
+    AstCFunc*           m_funcp;        // Current function
+    AstAssign*          m_assignp;      // Current top level assignment
+    bool                m_wholeVar;     // Under a node needing whole variables
+    bool                m_rewrite;      // Replacing references to packed variables
+    VarScopeList        m_vscps;        // Candidate variables, in tree order
+    WordMap             m_wordMembers;  // Variables packed into each word
+    int                 m_wordNum;      // Words created
+    VDouble0            m_statBits;     // Variables packed
+    VDouble0            m_statWords;    // Words created
+
+    // METHODS
+    static bool nameLess(const AstVarScope* ap, const AstVarScope* bp) {
+        // Natural order, so gen[2] sorts before gen[10] and replicas align across groups
+        const string& a = ap->varp()->name();
+        const string& b = bp->varp()->name();
+        size_t i = 0;
+        size_t j = 0;
+        while (i < a.length() && j < b.length()) {
+            if (isdigit(a[i]) && isdigit(b[j])) {
+                size_t iend = i; while (iend < a.length() && isdigit(a[iend])) ++iend;
+                size_t jend = j; while (jend < b.length() && isdigit(b[jend])) ++jend;
+                if (iend - i != jend - j) return (iend - i) < (jend - j);
+                int cmp = a.compare(i, iend - i, b, j, jend - j);
+                if (cmp) return cmp < 0;
+                i = iend;
+                j = jend;
+            } else {
+                if (a[i] != b[j]) return a[i] < b[j];
+                ++i;
+                ++j;
+            }
+        }
+        return (a.length() - i) < (b.length() - j);
+    }
+    void refsOf(AstNode* nodep, VarScopeSet& reads, VarScopeSet& writes, bool& impure) {
+        VarScopeSet rawReads;
+        VarScopeSet rawWrites;
+        PackBitsRefsVisitor visitor (nodep, &rawReads, &rawWrites);
+        if (visitor.impure()) impure = true;
+        // A word already made stands for each variable packed into it
+        for (int isWrite = 0; isWrite < 2; ++isWrite) {
+            VarScopeSet& raw = isWrite ? rawWrites : rawReads;
+            VarScopeSet& out = isWrite ? writes : reads;
+            for (VarScopeSet::iterator it = raw.begin(); it != raw.end(); ++it) {
+                out.insert(*it);
+                WordMap::iterator wit = m_wordMembers.find(*it);
+                if (wit != m_wordMembers.end()) {
+                    out.insert(wit->second.begin(), wit->second.end());
+                }
+            }
+        }
+    }
+    static bool intersects(const VarScopeSet& a, const VarScopeSet& b) {
+        for (VarScopeSet::const_iterator it = a.begin(); it != a.end(); ++it) {
+            if (b.find(*it) != b.end()) return true;
+        }
+        return false;
+    }
+    string shapeOf(AstNode* nodep, int& nodes) {
+        // Structure of an expression with candidate variables abstracted, or
+        // "" if it can't be packed
+        if (++nodes > SHAPE_MAX_NODES) return "";
+        if (nodep->nextp()) return "";
+        if (!nodep->isPure() || !nodep->isPredictOptimizable() || nodep->isOutputter()) return "";
+        if (AstVarRef* refp = VN_CAST(nodep, VarRef)) {
+            if (!refp->varScopep()->user1()) return "b";
+            return "v("+refp->varScopep()->name()+")";
+        } else if (AstConst* constp = VN_CAST(nodep, Const)) {
+            return "k("+constp->num().ascii()+")";
+        } else if (AstSel* selp = VN_CAST(nodep, Sel)) {
+            // a[i] of a shared vector, i varying across the group
+            AstVarRef* refp = VN_CAST(selp->fromp(), VarRef);
+            if (refp && VN_IS(selp->lsbp(), Const) && VN_IS(selp->widthp(), Const)) {
+                return "s("+refp->varScopep()->name()+")"+cvtToStr(selp->width());
+            }
+        } else if (VN_IS(nodep, NodeVarRef) || VN_IS(nodep, CCall)) {
+            return "";
+        }
+        string shape = nodep->typeName() + cvtToStr(nodep->width()) + "(";
+        AstNode* opsp[] = {nodep->op1p(), nodep->op2p(), nodep->op3p(), nodep->op4p()};
+        for (int i = 0; i < 4; ++i) {
+            if (!opsp[i]) continue;
+            string sub = shapeOf(opsp[i], nodes);
+            if (sub.empty()) return "";
+            shape += sub + ",";
+        }
+        return shape + ")";
+    }
+
+    void packWord(VarScopeList members) {
+        AstNode* firstStmtp = members[0]->user2p();
+        std::stable_sort(members.begin(), members.end(), nameLess);
+        AstScope* scopep = members[0]->scopep();
+        FileLine* fl = firstStmtp->fileline();
+        int width = static_cast<int>(members.size());
+        AstVar* varp = new AstVar(fl, AstVarType::MODULETEMP,
+                                  "__Vpack"+cvtToStr(++m_wordNum), VFlagLogicPacked(), width);
+        scopep->modp()->addStmtp(varp);
+        AstVarScope* wordp = new AstVarScope(fl, scopep, varp);
+        scopep->addVarp(wordp);
+        m_wordMembers[wordp] = members;
+        UINFO(4, "  Pack "<<width<<" bits into "<<wordp<<endl);
+        // Bit 0 is the first member, so CONCAT(exprN, ... CONCAT(expr1, expr0))
+        AstNode* rhsp = NULL;
+        for (int bit = 0; bit < width; ++bit) {
+            AstVarScope* vscp = members[bit];
+            vscp->user4p(wordp);
+            vscp->user5(bit);
+            AstNode* exprp = VN_CAST(vscp->user2p(), Assign)->rhsp()->unlinkFrBack();
+            rhsp = rhsp ? new AstConcat(fl, exprp, rhsp) : exprp;
+        }
+        firstStmtp->addHereThisAsNext(new AstAssign(fl, new AstVarRef(fl, wordp, true), rhsp));
+        for (int bit = 0; bit < width; ++bit) {
+            members[bit]->user2p()->unlinkFrBack()->deleteTree();
+            members[bit]->user2p(NULL);
+        }
+        ++m_statWords;
+        m_statBits += width;
+    }
+    void flushRun(VarScopeList& run) {
+        for (size_t start = 0; start + PACK_MIN <= run.size(); start += PACK_MAX) {
+            size_t end = std::min(run.size(), start + PACK_MAX);
+            packWord(VarScopeList(run.begin() + start, run.begin() + end));
+        }
+        run.clear();
+    }
+    void packGroup(const VarScopeList& group) {
+        AstCFunc* funcp = VN_CAST(group[0]->user3p(), CFunc);
+        VarScopeSet members (group.begin(), group.end());
+        // Find runs of the group's assignments that may be hoisted to the
+        // first of the run: nothing between reads what they write, nor
+        // writes what they read.
+        std::vector<VarScopeList> runs;
+        VarScopeList run;
+        VarScopeSet betweenReads;
+        VarScopeSet betweenWrites;
+        bool barrier = false;
+        for (AstNode* stmtp = funcp->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+            AstVarScope* memberp = NULL;
+            if (AstAssign* assp = VN_CAST(stmtp, Assign)) {
+                AstVarRef* lhsp = VN_CAST(assp->lhsp(), VarRef);
+                if (lhsp && members.find(lhsp->varScopep()) != members.end()
+                    && lhsp->varScopep()->user2p() == assp) {
+                    memberp = lhsp->varScopep();
+                }
+            }
+            VarScopeSet reads;
+            VarScopeSet writes;
+            bool impure = false;
+            refsOf(memberp ? VN_CAST(stmtp, Assign)->rhsp() : stmtp, reads, writes, impure);
+            if (memberp && !intersects(reads, members)) {
+                if (!run.empty()
+                    && (barrier || betweenReads.find(memberp) != betweenReads.end()
+                        || intersects(reads, betweenWrites))) {
+                    runs.push_back(run);
+                    run.clear();
+                }
+                if (run.empty()) {
+                    betweenReads.clear();
+                    betweenWrites.clear();
+                    barrier = false;
+                }
+                run.push_back(memberp);
+            } else if (!run.empty()) {
+                if (memberp) writes.insert(memberp);
+                betweenReads.insert(reads.begin(), reads.end());
+                betweenWrites.insert(writes.begin(), writes.end());
+                if (impure) barrier = true;
+            }
+        }
+        runs.push_back(run);
+        for (std::vector<VarScopeList>::iterator it = runs.begin(); it != runs.end(); ++it) {
+            flushRun(*it);
+        }
+    }
+    void packAll() {
+        GroupMap groups;
+        for (VarScopeList::iterator it = m_vscps.begin(); it != m_vscps.end(); ++it) {
+            AstVarScope* vscp = *it;
+            if (vscp->user1() || !vscp->user2p()) continue;
+            int nodes = 0;
+            string shape = shapeOf(VN_CAST(vscp->user2p(), Assign)->rhsp(), nodes);
+            if (shape.empty()) continue;
+            string key = (vscp->scopep()->name()+" "+vscp->user3p()->name()+" "+shape);
+            groups[key].push_back(vscp);
+        }
+        for (GroupMap::iterator it = groups.begin(); it != groups.end(); ++it) {
+            if (it->second.size() >= PACK_MIN) packGroup(it->second);
+        }
+    }
+
+    // VISITORS
+    virtual void visit(AstNetlist* nodep) {
+        iterateChildren(nodep);
+        packAll();
+        if (m_wordNum) {
+            m_rewrite = true;
+            iterateChildren(nodep);
+        }
+    }
+    virtual void visit(AstVarScope* nodep) {
+        if (m_rewrite) return;
+        AstVar* varp = nodep->varp();
+        if (varp->isBitLogic() && varp->width() == 1 && !varp->isSigned()
+            && VN_IS(varp->dtypeSkipRefp(), BasicDType)
+            && !varp->isIO() && !varp->isPrimaryIO() && !varp->isSigPublic()
+            && !varp->isSc() && !varp->isUsedClock() && !varp->isFuncLocal()
+            && !varp->isStatic() && !varp->isParam() && !nodep->isCircular()) {
+            m_vscps.push_back(nodep);
+        } else {
+            nodep->user1(true);
+        }
+    }
+    virtual void visit(AstCFunc* nodep) {
+        if (m_rewrite) { iterateChildren(nodep); return; }
+        m_funcp = nodep;
+        iterateAndNextNull(nodep->argsp());
+        iterateAndNextNull(nodep->initsp());
+        for (AstNode* stmtp = nodep->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+            m_assignp = VN_CAST(stmtp, Assign);
+            iterate(stmtp);
+        }
+        m_assignp = NULL;
+        iterateAndNextNull(nodep->finalsp());
+        m_funcp = NULL;
+    }
+    virtual void visit(AstVarRef* nodep) {
+        AstVarScope* vscp = nodep->varScopep();
+        UASSERT_OBJ(vscp, nodep, "Scope not assigned");
+        if (m_rewrite) {
+            if (AstVarScope* wordp = VN_CAST(vscp->user4p(), VarScope)) {
+                AstNode* newp = new AstSel(nodep->fileline(),
+                                           new AstVarRef(nodep->fileline(), wordp,
+                                                         nodep->lvalue()),
+                                           vscp->user5(), 1);
+                nodep->replaceWith(newp); nodep->deleteTree(); VL_DANGLING(nodep);
+            }
+            return;
+        }
+        if (vscp->user1()) return;
+        if (!m_funcp || m_wholeVar) {
+            vscp->user1(true);
+        } else if (nodep->lvalue()) {
+            if (!m_assignp || m_assignp->lhsp() != nodep) {
+                vscp->user1(true);
+            } else if (!m_funcp->slow()) {
+                if (vscp->user2p()) {
+                    vscp->user1(true);  // Multiple writers
+                } else {
+                    vscp->user2p(m_assignp);
+                    vscp->user3p(m_funcp);
+                }
+            }
+        }
+    }
+    void iterateWholeVar(AstNode* nodep) {
+        // Under these, references must remain to whole variables
+        bool lastWholeVar = m_wholeVar;
+        m_wholeVar = true;
+        iterateChildren(nodep);
+        m_wholeVar = lastWholeVar;
+    }
+    virtual void visit(AstCCall* nodep) { iterateWholeVar(nodep); }
+    virtual void visit(AstCMath* nodep) { iterateWholeVar(nodep); }
+    virtual void visit(AstCStmt* nodep) { iterateWholeVar(nodep); }
+    virtual void visit(AstUCStmt* nodep) { iterateWholeVar(nodep); }
+    virtual void visit(AstUCFunc* nodep) { iterateWholeVar(nodep); }
+    virtual void visit(AstTraceInc* nodep) { iterateWholeVar(nodep); }
+    virtual void visit(AstChangeDet* nodep) { iterateWholeVar(nodep); }
+    virtual void visit(AstSenItem* nodep) { iterateWholeVar(nodep); }
+    virtual void visit(AstNodeFTaskRef* nodep) { iterateWholeVar(nodep); }
+    //--------------------
+    // Default: Just iterate
+    virtual void visit(AstNode* nodep) {
+        iterateChildren(nodep);
+    }
+
+public:
+    // CONSTRUCTORS
+    explicit PackBitsVisitor(AstNetlist* nodep) {
+        m_funcp = NULL;
+        m_assignp = NULL;
+        m_wholeVar = false;
+        m_rewrite = false;
+        m_wordNum = 0;
+        iterate(nodep);
+    }
+    virtual ~PackBitsVisitor() {
+        V3Stats::addStat("Optimizations, Bits packed into words", m_statBits);
+        V3Stats::addStat("Optimizations, Packed bit words", m_statWords);
+    }
+};
+
+//######################################################################
+// PackBits class functions
+
+void V3PackBits::packBitsAll(AstNetlist* nodep) {
+    UINFO(2,__FUNCTION__<<": "<<endl);
+    {
+        PackBitsVisitor visitor (nodep);
+    }  // Destruct before checking
+    V3Global::dumpCheckGlobalTree("packbits", 0, v3Global.opt.dumpTreeLevel(__FILE__) >= 3);
+}
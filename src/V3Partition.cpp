@@ -1115,6 +1115,87 @@ static void partMergeEdgesFrom(V3Graph* mtasksp, LogicMTask* recipientp,
     }
 }
 
+//######################################################################
+// PartMergeChains
+
+// Linear-time coarsening to run ahead of PartContraction.
+//
+// Where an mtask A has a single successor B, and B has A as its single
+// predecessor, every path through either goes through both, so merging
+// them costs no parallelism: it is the first merge PartContraction would
+// make for that pair anyway, but PartContraction pays for scoring and
+// scoreboard churn on every such edge.  Netlists are full of these
+// chains, so collapsing them first shrinks the graph PartContraction sees
+// at a cost linear in the graph size.
+//
+// As in PartContraction, a merge is only done if the critical path
+// through the merged mtask stays within the cpLimit.  Critical paths
+// must be initialized on entry; they are approximately maintained while
+// merging and recomputed exactly afterwards if anything was merged.
+//
+// Ranks remain valid, as the successor is always the recipient.
+class PartMergeChains {
+private:
+    // MEMBERS
+    V3Graph* m_mtasksp;  // Mtask graph
+    uint32_t m_cpLimit;  // Max critical path through a merged mtask
+    unsigned m_mergesDone;  // Number of MTasks merged. For stats only.
+public:
+    // CONSTRUCTORS
+    PartMergeChains(V3Graph* mtasksp, uint32_t cpLimit)
+        : m_mtasksp(mtasksp), m_cpLimit(cpLimit), m_mergesDone(0) {}
+    // METHODS
+private:
+    static LogicMTask* chainSuccessorp(LogicMTask* mtaskp) {
+        // Return the successor if mtaskp and it form a mergeable chain link
+        V3GraphEdge* edgep = mtaskp->outBeginp();
+        if (!edgep || edgep->outNextp()) return NULL;  // Not exactly one successor
+        LogicMTask* succp = dynamic_cast<LogicMTask*>(edgep->top());
+        if (succp->inBeginp()->inNextp()) return NULL;  // Not exactly one predecessor
+        return succp;
+    }
+    void mergeInto(LogicMTask* recipientp, LogicMTask* donorp) {
+        // Remove the connecting edge first, so it's not moved to a self-edge
+        donorp->outBeginp()->unlinkDelete();
+        recipientp->setCritPathCost(GraphWay::FORWARD,
+                                    donorp->critPathCost(GraphWay::FORWARD));
+        recipientp->moveAllVerticesFrom(donorp);
+        partMergeEdgesFrom(m_mtasksp, recipientp, donorp, NULL);
+        donorp->unlinkDelete(m_mtasksp); VL_DANGLING(donorp);
+        ++m_mergesDone;
+    }
+public:
+    void go() {
+        vluint64_t startUsecs = 0;
+        if (debug() >= 3) startUsecs = V3Os::timeUsecs();
+
+        for (V3GraphVertex* vxp = m_mtasksp->verticesBeginp(); vxp; ) {
+            LogicMTask* mtaskp = dynamic_cast<LogicMTask*>(vxp);
+            vxp = vxp->verticesNextp();
+            // Follow the chain from here as far as the limit allows.  The
+            // recipient may be the next vertex, so advance past it first.
+            while (LogicMTask* succp = chainSuccessorp(mtaskp)) {
+                uint32_t cp = (mtaskp->critPathCost(GraphWay::FORWARD)
+                               + LogicMTask::stepCost(mtaskp->cost() + succp->cost())
+                               + succp->critPathCost(GraphWay::REVERSE));
+                if (cp > m_cpLimit) break;
+                if (vxp == mtaskp) vxp = vxp->verticesNextp();
+                mergeInto(succp, mtaskp); VL_DANGLING(mtaskp);
+                mtaskp = succp;
+            }
+        }
+        if (m_mergesDone) partInitCriticalPaths(m_mtasksp);
+
+        UINFO(4, "PartMergeChains() merged "<<m_mergesDone
+              <<" pairs of nodes in "<<(V3Os::timeUsecs() - startUsecs)
+              <<" usecs.\n");
+    }
+
+private:
+    VL_UNCOPYABLE(PartMergeChains);
+    VL_DEBUG_FUNC;
+};
+
 //######################################################################
 // PartContraction
 
@@ -2563,10 +2644,34 @@ void V3Partition::go(V3Graph* mtasksp) {
         hashGraphDebug(mtasksp, "mtasksp after fixDataHazards()");
     }
 
+    int targetParFactor = v3Global.opt.threads();
+    if (targetParFactor < 2) {
+        v3fatalSrc("We should not reach V3Partition when --threads <= 1");
+    }
+
+    // Set cpLimit to roughly totalGraphCost / nThreads
+    //
+    // Actually set it a bit lower, by a hardcoded fudge factor. This
+    // results in more smaller mtasks, which helps reduce fragmentation
+    // when scheduling them.
+    unsigned fudgeNumerator = 3;
+    unsigned fudgeDenominator = 5;
+    uint32_t cpLimit = ((totalGraphCost * fudgeNumerator)
+                        / (targetParFactor * fudgeDenominator));
+    UINFO(4, "V3Partition set cpLimit = "<<cpLimit<<endl);
+
     // Setup the critical path into and out of each node.
     partInitCriticalPaths(mtasksp);
     hashGraphDebug(mtasksp, "after partInitCriticalPaths()");
 
+    // Collapse single-predecessor/single-successor chains in linear time,
+    // so the much more expensive PartContraction has less to do.
+    if (v3Global.opt.threadsCoarsen()) {
+        PartMergeChains(mtasksp, cpLimit).go();
+        V3Partition::debugMTaskGraphStats(mtasksp, "chains");
+        hashGraphDebug(mtasksp, "after PartMergeChains()");
+    }
+
     // Order the graph. We know it's already ranked from fixDataHazards()
     // so we don't need to rank it again.
     //
@@ -2580,22 +2685,6 @@ void V3Partition::go(V3Graph* mtasksp) {
     // remove this later if it doesn't really help.
     mtasksp->orderPreRanked();
 
-    int targetParFactor = v3Global.opt.threads();
-    if (targetParFactor < 2) {
-        v3fatalSrc("We should not reach V3Partition when --threads <= 1");
-    }
-
-    // Set cpLimit to roughly totalGraphCost / nThreads
-    //
-    // Actually set it a bit lower, by a hardcoded fudge factor. This
-    // results in more smaller mtasks, which helps reduce fragmentation
-    // when scheduling them.
-    unsigned fudgeNumerator = 3;
-    unsigned fudgeDenominator = 5;
-    uint32_t cpLimit = ((totalGraphCost * fudgeNumerator)
-                        / (targetParFactor * fudgeDenominator));
-    UINFO(4, "V3Partition set cpLimit = "<<cpLimit<<endl);
-
     // Merge MTask nodes together, repeatedly, until the CP budget is
     // reached.  Coarsens the graph, usually by several orders of
     // magnitude.
@@ -368,7 +368,35 @@ class ProtectVisitor : public AstNVisitor {
 
     virtual void visit(AstNode* nodep) { }
 
+    AstVar* dpiPortClone(AstVar* varp) {
+        // The library is Verilated so is two-state; passing vectors as bit rather
+        // than logic avoids converting each call to/from svLogicVecVal aval/bval
+        AstVar* newp = varp->cloneTree(false);
+        AstBasicDType* basicp = VN_CAST(varp->dtypep(), BasicDType);
+        if (basicp && basicp->keyword() == AstBasicDTypeKwd::LOGIC
+            && !varp->childDTypep() && varp->width() != 1) {
+            newp->dtypep(newp->findBitDType(basicp->width(), basicp->widthMin(),
+                                            basicp->numeric()));
+        }
+        return newp;
+    }
+
     string cInputConnection(AstVar* varp) {
+        if (varp->basicp() && varp->basicp()->keyword() == AstBasicDTypeKwd::BIT
+            && varp->width() != 1) {
+            string toName = "handlep__V->"+varp->name();
+            if (varp->isWide()) {
+                return "VL_SET_W_SVBV("+cvtToStr(varp->width())+", "+toName
+                    +", "+varp->name()+");\n";
+            }
+            // The caller may leave the bits above the port width dirty
+            string width = cvtToStr(varp->width());
+            if (varp->isQuad()) {
+                return toName+" = VL_SET_QW("+varp->name()+") & VL_MASK_Q("+width+");\n";
+            } else {
+                return toName+" = *"+varp->name()+" & VL_MASK_I("+width+");\n";
+            }
+        }
         string frstmt;
         bool useSetWSvlv = V3Task::dpiToInternalFrStmt(varp, varp->name(), true, frstmt);
         if (useSetWSvlv) {
@@ -380,23 +408,25 @@ class ProtectVisitor : public AstNVisitor {
     void handleClock(AstVar* varp) {
         FileLine* fl = varp->fileline();
         handleInput(varp);
-        m_seqPortsp->addNodep(varp->cloneTree(false));
+        AstVar* dpiVarp = dpiPortClone(varp);
+        m_seqPortsp->addNodep(dpiVarp);
         m_seqParamsp->addText(fl, varp->name()+"\n");
         m_clkSensp->addText(fl, "edge("+varp->name()+")");
-        m_cSeqParamsp->addText(fl, varp->dpiArgType(true, false)+"\n");
-        m_cSeqClksp->addText(fl, cInputConnection(varp));
+        m_cSeqParamsp->addText(fl, dpiVarp->dpiArgType(true, false)+"\n");
+        m_cSeqClksp->addText(fl, cInputConnection(dpiVarp));
     }
 
     void handleDataInput(AstVar* varp) {
         FileLine* fl = varp->fileline();
         handleInput(varp);
-        m_comboPortsp->addNodep(varp->cloneTree(false));
+        AstVar* dpiVarp = dpiPortClone(varp);
+        m_comboPortsp->addNodep(dpiVarp);
         m_comboParamsp->addText(fl, varp->name()+"\n");
-        m_comboIgnorePortsp->addNodep(varp->cloneTree(false));
+        m_comboIgnorePortsp->addNodep(dpiPortClone(varp));
         m_comboIgnoreParamsp->addText(fl, varp->name()+"\n");
-        m_cComboParamsp->addText(fl, varp->dpiArgType(true, false)+"\n");
-        m_cComboInsp->addText(fl, cInputConnection(varp));
-        m_cIgnoreParamsp->addText(fl, varp->dpiArgType(true, false)+"\n");
+        m_cComboParamsp->addText(fl, dpiVarp->dpiArgType(true, false)+"\n");
+        m_cComboInsp->addText(fl, cInputConnection(dpiVarp));
+        m_cIgnoreParamsp->addText(fl, dpiVarp->dpiArgType(true, false)+"\n");
     }
 
     void handleInput(AstVar* varp) {
@@ -406,9 +436,10 @@ class ProtectVisitor : public AstNVisitor {
     void handleOutput(AstVar* varp) {
         FileLine* fl = varp->fileline();
         m_modPortsp->addNodep(varp->cloneTree(false));
-        m_comboPortsp->addNodep(varp->cloneTree(false));
+        AstVar* dpiVarp = dpiPortClone(varp);
+        m_comboPortsp->addNodep(dpiVarp);
         m_comboParamsp->addText(fl, varp->name()+"_combo__V\n");
-        m_seqPortsp->addNodep(varp->cloneTree(false));
+        m_seqPortsp->addNodep(dpiPortClone(varp));
         m_seqParamsp->addText(fl, varp->name()+"_tmp__V\n");
 
         AstNodeDType* comboDtypep = varp->dtypep()->cloneTree(false);
@@ -426,12 +457,12 @@ class ProtectVisitor : public AstNVisitor {
         m_nbAssignsp->addText(fl, varp->name()+"_seq__V <= "+varp->name()+"_tmp__V;\n");
         m_seqAssignsp->addText(fl, varp->name()+" = "+varp->name()+"_seq__V;\n");
         m_comboAssignsp->addText(fl, varp->name()+" = "+varp->name()+"_combo__V;\n");
-        m_cComboParamsp->addText(fl, varp->dpiArgType(true, false)+"\n");
-        m_cComboOutsp->addText(fl, V3Task::assignInternalToDpi(varp, false, true, "", "",
-                                                               "handlep__V->"));
-        m_cSeqParamsp->addText(fl, varp->dpiArgType(true, false)+"\n");
-        m_cSeqOutsp->addText(fl, V3Task::assignInternalToDpi(varp, false, true, "", "",
+        m_cComboParamsp->addText(fl, dpiVarp->dpiArgType(true, false)+"\n");
+        m_cComboOutsp->addText(fl, V3Task::assignInternalToDpi(dpiVarp, false, true, "", "",
                                                                "handlep__V->"));
+        m_cSeqParamsp->addText(fl, dpiVarp->dpiArgType(true, false)+"\n");
+        m_cSeqOutsp->addText(fl, V3Task::assignInternalToDpi(dpiVarp, false, true, "", "",
+                                                             "handlep__V->"));
     }
 
   public:
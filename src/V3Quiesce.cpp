@@ -0,0 +1,335 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Guard quiescent combinational regions
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2003-2019 by Wilson Snyder.  This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+//
+// Verilator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+//*************************************************************************
+// V3Quiesce's Transformations:
+//
+// Only when --quiesce-min-cost is non-zero:
+//
+// Each combo CFunc created by V3Order (one per run of combo logic in
+// the same scope, or with --threads, per run in the same mtask; these
+// leaf functions are called from the mtask bodies):
+//      Skip if it contains anything impure or any calls
+//      Skip if any variable it writes is also written by another
+//          non-slow function, or is writable by the user
+//      Skip if it reads a variable it writes before fully assigning it
+//      The remaining reads are the inputs of the region
+//      Skip if the body is too cheap compared to checking the inputs
+//      Otherwise, wrap the body:
+//          if (!__Vqsvalid || in0 != __Vqslast_in0 || ...) {
+//              __Vqslast_in0 = in0; ...
+//              __Vqsvalid = 1;
+//              {original body}
+//          }
+//
+// Since each output is written only by the region, and the outputs
+// are a function of the inputs alone, re-running the region with
+// unchanged inputs would produce the state it left last time.
+//
+// Slow functions (initial, settle, final) may also write the outputs;
+// _eval_initial and _eval_settle clear every valid flag so the next
+// _eval recomputes every guarded region.
+//
+//*************************************************************************
+
+#include "config_build.h"
+#include "verilatedos.h"
+
+#include "V3Global.h"
+#include "V3Ast.h"
+#include "V3Quiesce.h"
+#include "V3InstrCount.h"
+#include "V3Stats.h"
+
+#include <algorithm>
+#include <cstdarg>
+#include <vector>
+
+//######################################################################
+// Check one combo function, gathering its inputs
+
+class QuiesceRegionVisitor : public AstNVisitor {
+private:
+    // NODE STATE
+    // Entire netlist (from QuiesceVisitor):
+    //  AstVarScope::user1p()   -> AstCFunc*. Non-slow function writing the variable
+    //  AstVarScope::user2()    -> bool. True if written by more than one function
+    //  AstVarScope::user3()    -> int. Region number that fully assigned the variable
+    //  AstVarScope::user4()    -> int. Region number that recorded it as an input
+
+    // STATE
+    AstCFunc*           m_funcp;        // Function being checked
+    int                 m_regionNum;    // Unique number of this check
+    bool                m_ok;           // Region can be guarded
+    std::vector<AstVarScope*> m_inputs;  // Variables read but not produced here
+
+    // METHODS
+    VL_DEBUG_FUNC;  // Declare debug()
+
+    void clearOk(AstNode* nodep, const char* why) {
+        if (m_ok) {
+            UINFO(9, "   NoQuiesce: "<<why<<": "<<nodep<<endl);
+        }
+        m_ok = false;
+    }
+    static bool dtypeOk(AstNodeDType* dtypep) {
+        dtypep = dtypep->skipRefp();
+        if (AstBasicDType* basicp = VN_CAST(dtypep, BasicDType)) {
+            return !basicp->isOpaque();
+        } else if (VN_IS(dtypep, PackArrayDType)) {
+            return true;
+        } else if (AstNodeUOrStructDType* structp = VN_CAST(dtypep, NodeUOrStructDType)) {
+            return structp->packedUnsup();
+        }
+        return false;
+    }
+
+    // VISITORS
+    virtual void visit(AstVarRef* nodep) {
+        AstVarScope* vscp = nodep->varScopep();
+        UASSERT_OBJ(vscp, nodep, "Scope not assigned");
+        if (nodep->lvalue()) {
+            if (vscp->user1p() != m_funcp || vscp->user2()) {
+                clearOk(nodep, "Output has other writers");
+            } else if (vscp->varp()->isSigUserRWPublic()) {
+                clearOk(nodep, "Output is public");
+            }
+        } else if (vscp->user1p() == m_funcp) {
+            if (vscp->user3() != m_regionNum) {
+                clearOk(nodep, "Output read before assigned");
+            }
+        } else if (vscp->user4() != m_regionNum) {
+            vscp->user4(m_regionNum);
+            if (!dtypeOk(vscp->dtypep())) {
+                clearOk(nodep, "Input type can't be compared");
+            } else {
+                m_inputs.push_back(vscp);
+            }
+        }
+    }
+    virtual void visit(AstCCall* nodep) { clearOk(nodep, "Call"); }
+    virtual void visit(AstNodeFTaskRef* nodep) { clearOk(nodep, "Task call"); }
+    virtual void visit(AstCReturn* nodep) { clearOk(nodep, "Return"); }
+    virtual void visit(AstCStmt* nodep) { clearOk(nodep, "C statement"); }
+    virtual void visit(AstCMath* nodep) { clearOk(nodep, "C math"); }
+    virtual void visit(AstUCStmt* nodep) { clearOk(nodep, "User C statement"); }
+    virtual void visit(AstUCFunc* nodep) { clearOk(nodep, "User C function"); }
+    virtual void visit(AstCoverToggle* nodep) { clearOk(nodep, "Coverage"); }
+    virtual void visit(AstNode* nodep) {
+        if (!m_ok) return;
+        if (!nodep->isPure() || !nodep->isPredictOptimizable() || nodep->isOutputter()) {
+            clearOk(nodep, "Impure");
+            return;
+        }
+        iterateChildren(nodep);
+    }
+
+public:
+    // CONSTRUCTORS
+    QuiesceRegionVisitor(AstCFunc* funcp, int regionNum) {
+        m_funcp = funcp;
+        m_regionNum = regionNum;
+        m_ok = !funcp->initsp() && !funcp->finalsp();
+        for (AstNode* stmtp = funcp->stmtsp(); stmtp && m_ok; stmtp = stmtp->nextp()) {
+            iterate(stmtp);
+            // Once fully assigned at the top level, later reads are of this pass's value
+            if (AstNodeAssign* assp = VN_CAST(stmtp, NodeAssign)) {
+                if (AstVarRef* varrefp = VN_CAST(assp->lhsp(), VarRef)) {
+                    varrefp->varScopep()->user3(m_regionNum);
+                }
+            }
+        }
+    }
+    virtual ~QuiesceRegionVisitor() {}
+    bool ok() const { return m_ok; }
+    const std::vector<AstVarScope*>& inputs() const { return m_inputs; }
+    VL_UNCOPYABLE(QuiesceRegionVisitor);
+};
+
+//######################################################################
+// Quiesce state, as a visitor of each AstNode
+
+class QuiesceVisitor : public AstNVisitor {
+private:
+    // NODE STATE
+    // Entire netlist:
+    //  AstVarScope::user1p()   -> AstCFunc*. Non-slow function writing the variable
+    //  AstVarScope::user2()    -> bool. True if written by more than one function
+    //  AstVarScope::user3()    -> int. See QuiesceRegionVisitor
+    //  AstVarScope::user4()    -> int. See QuiesceRegionVisitor
+    AstUser1InUse       m_inuser1;
+    AstUser2InUse       m_inuser2;
+    AstUser3InUse       m_inuser3;
+    AstUser4InUse       m_inuser4;
+
+    // TYPES
+    typedef std::vector<AstCFunc*> FuncList;
+
+    // STATE
+    AstNodeModule*      m_topModp;      // Top module
+    AstScope*           m_scopetopp;    // Scope under TOPSCOPE
+    AstCFunc*           m_funcp;        // Current function
+    AstCFunc*           m_initFuncp;    // _eval_initial
+    AstCFunc*           m_settleFuncp;  // _eval_settle
+    FuncList            m_candidates;   // Combo functions to consider
+    int                 m_regionNum;    // Regions checked so far
+    VDouble0           m_statGuarded;  // Regions guarded
+    VDouble0           m_statCheap;    // Regions skipped as too cheap
+
+    // METHODS
+    VL_DEBUG_FUNC;  // Declare debug()
+
+    AstVarScope* newVarScope(AstVar* varp) {
+        m_topModp->addStmtp(varp);
+        AstVarScope* vscp = new AstVarScope(varp->fileline(), m_scopetopp, varp);
+        m_scopetopp->addVarp(vscp);
+        return vscp;
+    }
+    void quiesceFunc(AstCFunc* funcp) {
+        ++m_regionNum;
+        QuiesceRegionVisitor region (funcp, m_regionNum);
+        if (!region.ok() || region.inputs().empty()) return;
+        const std::vector<AstVarScope*>& inputs = region.inputs();
+
+        // Each input costs a compare now and a copy when the region runs
+        uint32_t guardCost = 0;
+        for (std::vector<AstVarScope*>::const_iterator it = inputs.begin();
+             it != inputs.end(); ++it) {
+            guardCost += 2 * std::max(1, (*it)->dtypep()->widthWords());
+        }
+        uint32_t bodyCost = V3InstrCount::count(funcp, false);
+        UINFO(8, "  Region cost "<<bodyCost<<" guard "<<guardCost<<" "<<funcp<<endl);
+        if (bodyCost < static_cast<uint32_t>(v3Global.opt.quiesceMinCost())
+            || bodyCost < GUARD_RATIO * guardCost) {
+            ++m_statCheap;
+            return;
+        }
+        ++m_statGuarded;
+
+        FileLine* fl = funcp->fileline();
+        string prefix = "__Vqs"+cvtToStr(m_regionNum)+"__";
+        AstVarScope* validp = newVarScope(new AstVar(fl, AstVarType::MODULETEMP,
+                                                     prefix+"valid", VFlagBitPacked(), 1));
+        AstNode* condp = new AstLogNot(fl, new AstVarRef(fl, validp, false));
+        AstNode* updatesp = NULL;
+        for (std::vector<AstVarScope*>::const_iterator it = inputs.begin();
+             it != inputs.end(); ++it) {
+            AstVarScope* vscp = *it;
+            AstVar* varp = vscp->varp();
+            AstVarScope* lastp = newVarScope(
+                new AstVar(varp->fileline(), AstVarType::MODULETEMP,
+                           prefix+vscp->scopep()->nameDotless()+"__"+varp->shortName(),
+                           varp));
+            AstNode* changep;
+            if (varp->isDouble()) {
+                changep = new AstNeqD(fl, new AstVarRef(fl, vscp, false),
+                                      new AstVarRef(fl, lastp, false));
+            } else {
+                changep = new AstNeq(fl, new AstVarRef(fl, vscp, false),
+                                     new AstVarRef(fl, lastp, false));
+            }
+            condp = new AstLogOr(fl, condp, changep);
+            updatesp = AstNode::addNextNull(updatesp,
+                                            new AstAssign(fl, new AstVarRef(fl, lastp, true),
+                                                          new AstVarRef(fl, vscp, false)));
+        }
+        updatesp->addNext(new AstAssign(fl, new AstVarRef(fl, validp, true),
+                                        new AstConst(fl, AstConst::LogicTrue())));
+        updatesp->addNext(funcp->stmtsp()->unlinkFrBackWithNext());
+        funcp->addStmtsp(new AstIf(fl, condp, updatesp, NULL));
+
+        // Initial and settle code may rewrite the outputs; force a recompute
+        m_initFuncp->addStmtsp(new AstAssign(fl, new AstVarRef(fl, validp, true),
+                                             new AstConst(fl, AstConst::LogicFalse())));
+        m_settleFuncp->addStmtsp(new AstAssign(fl, new AstVarRef(fl, validp, true),
+                                               new AstConst(fl, AstConst::LogicFalse())));
+    }
+
+    // CONSTANTS
+    enum MiscConsts {
+        GUARD_RATIO = 4         // Body must cost this many times the guard
+    };
+
+    // VISITORS
+    virtual void visit(AstNodeModule* nodep) {
+        if (nodep->isTop()) m_topModp = nodep;
+        iterateChildren(nodep);
+    }
+    virtual void visit(AstTopScope* nodep) {
+        m_scopetopp = nodep->scopep();
+        UASSERT_OBJ(m_scopetopp, nodep,
+                    "No scope found on top level, perhaps you have no statements?");
+        iterateChildren(nodep);
+    }
+    virtual void visit(AstCFunc* nodep) {
+        m_funcp = nodep;
+        if (nodep->name() == "_eval_initial") m_initFuncp = nodep;
+        else if (nodep->name() == "_eval_settle") m_settleFuncp = nodep;
+        else if (!nodep->slow() && nodep->stmtsp()
+                 && nodep->name().compare(0, 6, "_combo") == 0) {
+            m_candidates.push_back(nodep);
+        }
+        iterateChildren(nodep);
+        m_funcp = NULL;
+    }
+    virtual void visit(AstVarRef* nodep) {
+        // Slow functions only run before the first _eval, see quiesceFunc
+        if (nodep->lvalue() && !(m_funcp && m_funcp->slow())) {
+            AstVarScope* vscp = nodep->varScopep();
+            if (!m_funcp || (vscp->user1p() && vscp->user1p() != m_funcp)) vscp->user2(true);
+            else vscp->user1p(m_funcp);
+        }
+    }
+    //--------------------
+    // Default: Just iterate
+    virtual void visit(AstNode* nodep) {
+        iterateChildren(nodep);
+    }
+
+public:
+    // CONSTRUCTORS
+    explicit QuiesceVisitor(AstNetlist* nodep) {
+        m_topModp = NULL;
+        m_scopetopp = NULL;
+        m_funcp = NULL;
+        m_initFuncp = NULL;
+        m_settleFuncp = NULL;
+        m_regionNum = 0;
+        iterate(nodep);
+        if (m_topModp && m_scopetopp && m_initFuncp && m_settleFuncp) {
+            for (FuncList::iterator it = m_candidates.begin(); it != m_candidates.end(); ++it) {
+                quiesceFunc(*it);
+            }
+        }
+    }
+    virtual ~QuiesceVisitor() {
+        V3Stats::addStat("Optimizations, Quiesce regions guarded", m_statGuarded);
+        V3Stats::addStat("Optimizations, Quiesce regions too cheap", m_statCheap);
+    }
+};
+
+//######################################################################
+// Quiesce class functions
+
+void V3Quiesce::quiesceAll(AstNetlist* nodep) {
+    UINFO(2,__FUNCTION__<<": "<<endl);
+    {
+        QuiesceVisitor visitor (nodep);
+    }  // Destruct before checking
+    V3Global::dumpCheckGlobalTree("quiesce", 0, v3Global.opt.dumpTreeLevel(__FILE__) >= 3);
+}
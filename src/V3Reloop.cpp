@@ -31,6 +31,36 @@
 //
 //   Likewise vector assign to the same constant converted to a loop.
 //
+//   More generally, any series of assignments that are the same other
+//   than constant select indices, where each index is either fixed or
+//   moves in step with the left hand side index:
+//
+//      ASSIGN(ARRAYREF(a, #), AND(ARRAYREF(b, #+2), ARRAYREF(c, 7)))
+//      ASSIGN(ARRAYREF(a, #+1), AND(ARRAYREF(b, #+3), ARRAYREF(c, 7)))
+//      ->
+//      FOR(__Vilp = low; __Vilp <= high; ++__Vlip)
+//         ASSIGN(ARRAYREF(a, __Vilp), AND(ARRAYREF(b, __Vilp+2), ARRAYREF(c, 7)))
+//
+//   This re-rolls generate loops and wide (WORDSEL) operations over
+//   arrayed state.  The right hand side must not read the left hand
+//   side variable, so the iterations are independent.
+//
+//   Likewise a series of calls to the same function in consecutive
+//   instances of a module (as V3Combine leaves when it shares one
+//   function between all the instances):
+//
+//      CCALL(vlSymsp->TOP__t__core_0., func)
+//      CCALL(vlSymsp->TOP__t__core_1., func)
+//      ->
+//      FOR(__Vilp = low; __Vilp <= high; ++__Vlip)
+//         CCALL(vlSymsp->__Vinst__core[__Vilp]->, func)
+//
+//   The symbol table then holds a pointer to each instance of the module.
+//
+//   Neither is done inside a thread MTASKBODY.  It is emitted as a
+//   function of its own, so can't see the loop variable, which is a
+//   local of the CFunc holding the MTASKBODY.
+//
 //*************************************************************************
 
 #include "config_build.h"
@@ -43,8 +73,10 @@
 
 #include <algorithm>
 #include <cstdarg>
+#include <map>
 
 #define RELOOP_MIN_ITERS 40  // Need at least this many loops to do this optimization
+#define RELOOP_MIN_CALLS 8  // Need at least this many calls to do this optimization
 
 //######################################################################
 
@@ -52,30 +84,129 @@ class ReloopVisitor : public AstNVisitor {
 private:
     // TYPES
     typedef std::vector<AstNodeAssign*>  AssVec;
+    typedef std::vector<AstNodeSel*>  SelVec;
+    enum SelMode { SEL_UNKNOWN, SEL_FIXED, SEL_RELATIVE };
+    typedef std::vector<SelMode>  SelModeVec;
+    typedef std::vector<AstCCall*>  CallVec;
+    typedef std::map<string,AstScope*>  ScopeMap;
 
     // NODE STATE
     // AstCFunc::user1p      -> Var* for temp var, 0=not set yet
+    // AstScope::user2       -> int. Index in module's instance table
     AstUser1InUse       m_inuser1;
+    AstUser2InUse       m_inuser2;
 
     // STATE
     VDouble0            m_statReloops;  // Statistic tracking
     VDouble0            m_statReItems;  // Statistic tracking
+    VDouble0            m_statReCalls;  // Statistic tracking
     AstCFunc*           m_cfuncp;       // Current block
 
     AssVec              m_mgAssignps;   // List of assignments merging
     AstCFunc*           m_mgCfuncp;     // Parent C function
     AstNode*            m_mgNextp;      // Next node
     AstNodeSel*         m_mgSelLp;      // Parent select, NULL = idle
-    AstNodeSel*         m_mgSelRp;      // Parent select, NULL = constant
     AstNodeVarRef*      m_mgVarrefLp;   // Parent varref
-    AstNodeVarRef*      m_mgVarrefRp;   // Parent varref, NULL = constant
-    AstConst*           m_mgConstRp;    // Parent RHS constant, NULL = sel
+    SelVec              m_mgSelRps;     // Constant index selects on first RHS
+    SelModeVec          m_mgSelModes;   // How each of m_mgSelRps varies
     uint32_t            m_mgIndexLo;    // Merge range
     uint32_t            m_mgIndexHi;    // Merge range
 
+    ScopeMap            m_instScopes;   // Scope for each absolute call hiername
+    CallVec             m_cmCallps;     // List of calls merging
+    AstCFunc*           m_cmCfuncp;     // Parent C function
+    AstNode*            m_cmNextp;      // Next node
+    AstScope*           m_cmScopep;     // Scope of last call merged
+
     // METHODS
     VL_DEBUG_FUNC;  // Declare debug()
 
+    static void findConstSels(AstNode* nodep, SelVec& sels) {
+        // Constant index selects under nodep, in tree order
+        AstNodeSel* selp = VN_CAST(nodep, NodeSel);
+        if (selp && VN_IS(selp->bitp(), Const)) {
+            sels.push_back(selp);
+            findConstSelsList(selp->fromp(), sels);
+            return;
+        }
+        findConstSelsList(nodep->op1p(), sels);
+        findConstSelsList(nodep->op2p(), sels);
+        findConstSelsList(nodep->op3p(), sels);
+        findConstSelsList(nodep->op4p(), sels);
+    }
+    static void findConstSelsList(AstNode* nodep, SelVec& sels) {
+        for (; nodep; nodep = nodep->nextp()) findConstSels(nodep, sels);
+    }
+    static bool sameExceptIndices(const AstNode* ap, const AstNode* bp) {
+        // Like sameTree, but constant select indices may differ
+        if (!ap && !bp) return true;
+        if (!ap || !bp) return false;
+        if (ap->type() != bp->type()
+            || ap->dtypep() != bp->dtypep()
+            || !ap->same(bp)) return false;
+        const AstNodeSel* aselp = VN_CAST_CONST(ap, NodeSel);
+        if (aselp && VN_IS(aselp->bitp(), Const)) {
+            const AstNodeSel* bselp = VN_CAST_CONST(bp, NodeSel);
+            return (VN_IS(bselp->bitp(), Const)
+                    && sameListExceptIndices(aselp->fromp(), bselp->fromp()));
+        }
+        return (sameListExceptIndices(ap->op1p(), bp->op1p())
+                && sameListExceptIndices(ap->op2p(), bp->op2p())
+                && sameListExceptIndices(ap->op3p(), bp->op3p())
+                && sameListExceptIndices(ap->op4p(), bp->op4p()));
+    }
+    static bool sameListExceptIndices(const AstNode* ap, const AstNode* bp) {
+        for (; ap || bp; ap = ap->nextp(), bp = bp->nextp()) {
+            if (!sameExceptIndices(ap, bp)) return false;
+        }
+        return true;
+    }
+    static bool rhsOk(const AstNode* nodep, const AstVar* lvarp) {
+        // Pure, and doesn't read the variable being assigned
+        for (; nodep; nodep = nodep->nextp()) {
+            if (!nodep->isPure() || VN_IS(nodep, CCall)
+                || VN_IS(nodep, CMath) || VN_IS(nodep, CStmt)) return false;
+            const AstNodeVarRef* varrefp = VN_CAST_CONST(nodep, NodeVarRef);
+            if (varrefp && varrefp->varp() == lvarp) return false;
+            const AstNodeSel* selp = VN_CAST_CONST(nodep, NodeSel);
+            if (selp && VN_IS(selp->bitp(), Const)
+                && VN_CAST_CONST(selp->bitp(), Const)->width() > 32) return false;
+            if (!rhsOk(nodep->op1p(), lvarp) || !rhsOk(nodep->op2p(), lvarp)
+                || !rhsOk(nodep->op3p(), lvarp) || !rhsOk(nodep->op4p(), lvarp)) return false;
+        }
+        return true;
+    }
+    static uint32_t selIndex(const AstNodeSel* selp) {
+        return VN_CAST(selp->bitp(), Const)->toUInt();
+    }
+    bool selModesMatch(AstNodeAssign* nodep, uint32_t index) {
+        // Return true if each RHS index is fixed, or moves with the LHS
+        // index, consistently with the assignments merged so far
+        SelVec sels;
+        findConstSelsList(nodep->rhsp(), sels);
+        UASSERT_OBJ(sels.size() == m_mgSelRps.size(), nodep, "sameExceptIndices mismatch");
+        uint32_t index0 = selIndex(m_mgSelLp);
+        for (size_t i = 0; i < sels.size(); ++i) {
+            uint32_t sel0 = selIndex(m_mgSelRps[i]);
+            uint32_t sel = selIndex(sels[i]);
+            bool fixed = (sel == sel0);
+            bool relative = (sel - index == sel0 - index0);
+            SelMode mode = m_mgSelModes[i];
+            if (mode == SEL_UNKNOWN) mode = fixed ? SEL_FIXED : relative ? SEL_RELATIVE : mode;
+            if (!((mode == SEL_FIXED && fixed) || (mode == SEL_RELATIVE && relative))) {
+                return false;
+            }
+        }
+        // Record modes only once all matched
+        for (size_t i = 0; i < sels.size(); ++i) {
+            if (m_mgSelModes[i] == SEL_UNKNOWN) {
+                m_mgSelModes[i] = (selIndex(sels[i]) == selIndex(m_mgSelRps[i])
+                                   ? SEL_FIXED : SEL_RELATIVE);
+            }
+        }
+        return true;
+    }
+
     AstVar* findCreateVarTemp(FileLine* fl, AstCFunc* cfuncp) {
         AstVar* varp = VN_CAST(cfuncp->user1p(), Var);
         if (!varp) {
@@ -118,13 +249,19 @@ private:
                 whilep->addBodysp(bodyp);
 
                 // Replace constant index with new loop index
+                uint32_t index0 = selIndex(m_mgSelLp);
                 AstNode* lbitp = m_mgSelLp->bitp();
                 lbitp->replaceWith(new AstVarRef(fl, itp, false));
                 lbitp->deleteTree(); VL_DANGLING(lbitp);
-                if (m_mgSelRp) {  // else constant and no replace
-                    AstNode* rbitp = m_mgSelRp->bitp();
-                    rbitp->replaceWith(new AstVarRef(fl, itp, false));
-                    rbitp->deleteTree(); VL_DANGLING(lbitp);
+                for (size_t i = 0; i < m_mgSelRps.size(); ++i) {
+                    if (m_mgSelModes[i] != SEL_RELATIVE) continue;  // Fixed index
+                    AstNode* rbitp = m_mgSelRps[i]->bitp();
+                    // Offsets are modulo 2^32, like the indices
+                    uint32_t offset = selIndex(m_mgSelRps[i]) - index0;
+                    AstNode* newp = new AstVarRef(fl, itp, false);
+                    if (offset) newp = new AstAdd(fl, newp, new AstConst(fl, offset));
+                    rbitp->replaceWith(newp);
+                    rbitp->deleteTree(); VL_DANGLING(rbitp);
                 }
                 if (debug()>=9) initp->dumpTree(cout, "-new: ");
                 if (debug()>=9) whilep->dumpTree(cout, "-new: ");
@@ -140,10 +277,80 @@ private:
             // Setup for next merge
             m_mgAssignps.clear();
             m_mgSelLp = NULL;
-            m_mgSelRp = NULL;
             m_mgVarrefLp = NULL;
-            m_mgVarrefRp = NULL;
-            m_mgConstRp = NULL;
+            m_mgSelRps.clear();
+            m_mgSelModes.clear();
+        }
+    }
+
+    void findInstances(AstNetlist* nodep) {
+        // Number the instances of each module that has enough of them
+        for (AstNodeModule* modp = nodep->modulesp();
+             modp; modp = VN_CAST(modp->nextp(), NodeModule)) {
+            if (modp->isTop()) continue;
+            int instances = 0;
+            for (AstNode* stmtp = modp->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+                if (AstScope* scopep = VN_CAST(stmtp, Scope)) {
+                    scopep->user2(instances++);
+                    // Per V3Descope's absolute reference
+                    m_instScopes.insert(make_pair(scopep->nameVlSym()+".", scopep));
+                }
+            }
+            if (instances < RELOOP_MIN_CALLS) {
+                for (AstNode* stmtp = modp->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+                    if (AstScope* scopep = VN_CAST(stmtp, Scope)) {
+                        m_instScopes.erase(scopep->nameVlSym()+".");
+                    }
+                }
+            }
+        }
+    }
+    AstScope* callScopep(AstCCall* nodep) {
+        // Instance a call is made through, if it may be rerolled
+        if (nodep->argsp() || nodep->funcp()->rtnTypeVoid() != "void") return NULL;
+        ScopeMap::iterator it = m_instScopes.find(nodep->hiername());
+        if (it == m_instScopes.end()) return NULL;
+        return it->second;
+    }
+    void callMergeEnd() {
+        if (!m_cmCallps.empty()) {
+            int items = m_cmCallps.size();
+            if (items >= RELOOP_MIN_CALLS) {
+                AstCCall* bodyp = m_cmCallps.front();
+                AstNodeModule* modp = m_cmScopep->modp();
+                UINFO(6, "Reloop merging calls="<<items<<" "<<bodyp<<endl);
+                ++m_statReloops;
+                m_statReCalls += items;
+                modp->instTable(true);
+
+                FileLine* fl = bodyp->fileline();
+                AstVar* itp = findCreateVarTemp(fl, m_cmCfuncp);
+                uint32_t indexLo = callScopep(bodyp)->user2();
+                uint32_t indexHi = m_cmScopep->user2();
+                AstNode* initp = new AstAssign(fl, new AstVarRef(fl, itp, true),
+                                               new AstConst(fl, indexLo));
+                AstNode* condp = new AstLte(fl, new AstVarRef(fl, itp, false),
+                                            new AstConst(fl, indexHi));
+                AstNode* incp = new AstAssign(fl, new AstVarRef(fl, itp, true),
+                                              new AstAdd(fl, new AstConst(fl, 1),
+                                                         new AstVarRef(fl, itp, false)));
+                AstWhile* whilep = new AstWhile(fl, condp, NULL, incp);
+                initp->addNext(whilep);
+                bodyp->replaceWith(initp);
+                whilep->addBodysp(bodyp);
+                bodyp->hiername(string("vlSymsp->")+modp->instTableName()
+                                +"["+itp->name()+"]->");
+                if (debug()>=9) whilep->dumpTree(cout, "-new: ");
+
+                for (CallVec::iterator it=m_cmCallps.begin(); it!=m_cmCallps.end(); ++it) {
+                    AstCCall* callp = *it;
+                    if (callp != bodyp) {
+                        callp->unlinkFrBack()->deleteTree(); VL_DANGLING(callp);
+                    }
+                }
+            }
+            m_cmCallps.clear();
+            m_cmScopep = NULL;
         }
     }
 
@@ -151,51 +358,64 @@ private:
     virtual void visit(AstCFunc* nodep) {
         m_cfuncp = nodep;
         iterateChildren(nodep);
+        callMergeEnd();
         m_cfuncp = NULL;
     }
+    virtual void visit(AstCCall* nodep) {
+        if (!m_cfuncp) return;
+        AstScope* scopep = callScopep(nodep);
+        if (!scopep) { callMergeEnd(); return; }
+        if (!m_cmCallps.empty()) {
+            AstCCall* firstp = m_cmCallps.front();
+            if (m_cmCfuncp == m_cfuncp
+                && m_cmNextp == nodep
+                && firstp->funcp() == nodep->funcp()
+                && firstp->argTypes() == nodep->argTypes()
+                && scopep->modp() == m_cmScopep->modp()
+                && scopep->user2() == m_cmScopep->user2() + 1) {
+                // Next instance in order; continue merge
+                m_cmCallps.push_back(nodep);
+                m_cmNextp = nodep->nextp();
+                m_cmScopep = scopep;
+                return;
+            }
+            callMergeEnd();
+        }
+        // Merge start
+        m_cmCallps.push_back(nodep);
+        m_cmCfuncp = m_cfuncp;
+        m_cmNextp = nodep->nextp();
+        m_cmScopep = scopep;
+    }
     virtual void visit(AstNodeAssign* nodep) {
         if (!m_cfuncp) return;
 
         // Left select WordSel or ArraySel
         AstNodeSel* lselp = VN_CAST(nodep->lhsp(), NodeSel);
-        if (!lselp) { mergeEnd(); return; }  // Not ever merged
+        if (!VN_IS(lselp, WordSel) && !VN_IS(lselp, ArraySel)) {
+            mergeEnd(); return;  // Not ever merged
+        }
         // Of a constant index
         AstConst* lbitp = VN_CAST(lselp->bitp(), Const);
         if (!lbitp) { mergeEnd(); return; }
-        if (lbitp->width() > 32) { mergeEnd(); return; }  // Assoc arrays can do this
+        if (lbitp->width() > 32) { mergeEnd(); return; }  // Wider than the loop variable
         uint32_t index = lbitp->toUInt();
         // Of variable
         AstNodeVarRef* lvarrefp = VN_CAST(lselp->fromp(), NodeVarRef);
         if (!lvarrefp) { mergeEnd(); return; }
 
-        // RHS is a constant or a select
-        AstConst* rconstp = VN_CAST(nodep->rhsp(), Const);
-        AstNodeSel* rselp = VN_CAST(nodep->rhsp(), NodeSel);
-        AstNodeVarRef* rvarrefp = NULL;
-        if (rconstp) {  // Ok
-        } else {
-            if (!rselp) { mergeEnd(); return; }
-            AstConst* rbitp = VN_CAST(rselp->bitp(), Const);
-            rvarrefp = VN_CAST(rselp->fromp(), NodeVarRef);
-            if (!rbitp || rbitp->toUInt() != index
-                || !rvarrefp
-                || lvarrefp->varp() == rvarrefp->varp()) {
-                mergeEnd(); return;
-            }
-        }
+        // RHS is pure and independent of the LHS variable
+        if (!rhsOk(nodep->rhsp(), lvarrefp->varp())) { mergeEnd(); return; }
 
         if (m_mgSelLp) {  // Old merge
             if (m_mgCfuncp == m_cfuncp
                 && m_mgNextp == nodep
                 && m_mgSelLp->same(lselp)
                 && m_mgVarrefLp->same(lvarrefp)
-                && (m_mgConstRp
-                    ? (rconstp && m_mgConstRp->same(rconstp))
-                    : (rselp
-                       && m_mgSelRp->same(rselp)
-                       && m_mgVarrefRp->same(rvarrefp)))
+                && sameExceptIndices(m_mgAssignps.front(), nodep)
                 && (index == m_mgIndexLo-1
-                    || index == m_mgIndexHi+1)) {
+                    || index == m_mgIndexHi+1)
+                && selModesMatch(nodep, index)) {
                 // Sequentially next to last assign; continue merge
                 if (index == m_mgIndexLo-1) m_mgIndexLo = index;
                 else if (index == m_mgIndexHi+1) m_mgIndexHi = index;
@@ -217,14 +437,23 @@ private:
         m_mgCfuncp = m_cfuncp;
         m_mgNextp = nodep->nextp();
         m_mgSelLp = lselp;
-        m_mgSelRp = rselp;
         m_mgVarrefLp = lvarrefp;
-        m_mgVarrefRp = rvarrefp;
-        m_mgConstRp = rconstp;
+        findConstSelsList(nodep->rhsp(), m_mgSelRps);
+        m_mgSelModes.assign(m_mgSelRps.size(), SEL_UNKNOWN);
         m_mgIndexLo = index;
         m_mgIndexHi = index;
         UINFO(9, "Start merge i="<<index<<" "<<nodep<<endl);
     }
+    virtual void visit(AstMTaskBody* nodep) {
+        // Emitted into its own function, so can't use the CFunc's loop
+        // variable; neither assignments nor calls are merged in it
+        mergeEnd();
+        callMergeEnd();
+        AstCFunc* oldFuncp = m_cfuncp;
+        m_cfuncp = NULL;
+        iterateChildren(nodep);
+        m_cfuncp = oldFuncp;
+    }
     //--------------------
     // Default: Just iterate
     virtual void visit(AstVar* nodep) {}  // Speedup
@@ -240,17 +469,20 @@ public:
         m_mgCfuncp = NULL;
         m_mgNextp = NULL;
         m_mgSelLp = NULL;
-        m_mgSelRp = NULL;
         m_mgVarrefLp = NULL;
-        m_mgVarrefRp = NULL;
-        m_mgConstRp = NULL;
         m_mgIndexLo = 0;
         m_mgIndexHi = 0;
+        m_cmCfuncp = NULL;
+        m_cmNextp = NULL;
+        m_cmScopep = NULL;
+        // Instance table references are not --protect-ids safe
+        if (!v3Global.opt.protectIds()) findInstances(nodep);
         iterate(nodep);
     }
     virtual ~ReloopVisitor() {
         V3Stats::addStat("Optimizations, Reloops", m_statReloops);
         V3Stats::addStat("Optimizations, Reloop iterations", m_statReItems);
+        V3Stats::addStat("Optimizations, Reloop instance calls", m_statReCalls);
     }
 };
 
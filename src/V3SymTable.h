@@ -29,10 +29,13 @@
 #include "V3File.h"
 #include "V3String.h"
 
+#include <algorithm>
 #include <cstdarg>
 #include <map>
 #include <iomanip>
 #include <memory>
+#include <vector>
+#include VL_INCLUDE_UNORDERED_MAP
 
 class VSymGraph;
 class VSymEnt;
@@ -47,8 +50,11 @@ class VSymEnt {
     // Symbol table that can have a "superior" table for resolving upper references
 private:
     // MEMBERS
-    typedef std::multimap<string,VSymEnt*> IdNameMap;
+    typedef vl_unordered_map<string,VSymEnt*> IdNameMap;
+    typedef std::vector<std::pair<string,VSymEnt*> > IdNameList;
+    typedef std::vector<VSymEnt*> UnnamedList;
     IdNameMap   m_idNameMap;    // Hash of variables by name
+    UnnamedList m_unnamed;      // Entries with empty name (may be multiple), in insertion order
     AstNode*    m_nodep;        // Node that entry belongs to
     VSymEnt*    m_fallbackp;    // Table "above" this one in name scope, for fallback resolution
     VSymEnt*    m_parentp;      // Table that created this table, dot notation needed to resolve into it
@@ -65,6 +71,24 @@ private:
 #else
     static inline int debug() { return 0; }  // NOT runtime, too hot of a function
 #endif
+    static bool idNameLess(const IdNameList::value_type& lhs,
+                           const IdNameList::value_type& rhs) {
+        return lhs.first < rhs.first;
+    }
+    void sortedIds(IdNameList& listr) const {
+        // Entries in name order, for anything where iteration order is visible.
+        // Lookups use the hash directly; only iteration pays for ordering.
+        listr.clear();
+        listr.reserve(m_unnamed.size() + m_idNameMap.size());
+        for (UnnamedList::const_iterator it = m_unnamed.begin(); it != m_unnamed.end(); ++it) {
+            listr.push_back(make_pair(string(), *it));
+        }
+        size_t namedStart = listr.size();
+        for (IdNameMap::const_iterator it = m_idNameMap.begin(); it != m_idNameMap.end(); ++it) {
+            listr.push_back(*it);
+        }
+        std::sort(listr.begin() + namedStart, listr.end(), idNameLess);
+    }
 public:
     void dumpIterate(std::ostream& os, VSymConstMap& doneSymsr, const string& indent,
                      int numLevels, const string& searchName) const {
@@ -79,7 +103,9 @@ public:
             os<<indent<<"| ^ duplicate, so no children printed\n";
         } else {
             doneSymsr.insert(this);
-            for (IdNameMap::const_iterator it=m_idNameMap.begin(); it!=m_idNameMap.end(); ++it) {
+            IdNameList ids;
+            sortedIds(ids);
+            for (IdNameList::const_iterator it = ids.begin(); it != ids.end(); ++it) {
                 if (numLevels >= 1) {
                     it->second->dumpIterate(os, doneSymsr, indent+"| ", numLevels-1, it->first);
                 }
@@ -122,7 +148,9 @@ public:
     void insert(const string& name, VSymEnt* entp) {
         UINFO(9, "     SymInsert se"<<cvtToHex(this)
               <<" '"<<name<<"' se"<<cvtToHex(entp)<<"  "<<entp->nodep()<<endl);
-        if (name != "" && m_idNameMap.find(name) != m_idNameMap.end()) {
+        if (name == "") {
+            m_unnamed.push_back(entp);
+        } else if (m_idNameMap.find(name) != m_idNameMap.end()) {
             if (!V3Error::errorCount()) {  // Else may have just reported warning
                 if (debug()>=9 || V3Error::debugDefault()) dump(cout,"- err-dump: ", 1);
                 entp->nodep()->v3fatalSrc("Inserting two symbols with same name: "<<name<<endl);
@@ -144,6 +172,7 @@ public:
     VSymEnt* findIdFlat(const string& name) const {
         // Find identifier without looking upward through symbol hierarchy
         // First, scan this begin/end block or module for the name
+        if (VL_UNLIKELY(name == "")) return m_unnamed.empty() ? NULL : m_unnamed.front();
         IdNameMap::const_iterator it = m_idNameMap.find(name);
         UINFO(9, "     SymFind   se"<<cvtToHex(this)<<" '"<<name
               <<"' -> "<<(it == m_idNameMap.end() ? "NONE"
@@ -161,8 +190,9 @@ public:
     }
     void candidateIdFlat(VSpellCheck* spellerp, const VNodeMatcher* matcherp) const {
         // Suggest alternative symbol candidates without looking upward through symbol hierarchy
-        for (IdNameMap::const_iterator it = m_idNameMap.begin();
-             it != m_idNameMap.end(); ++it) {
+        IdNameList ids;
+        sortedIds(ids);
+        for (IdNameList::const_iterator it = ids.begin(); it != ids.end(); ++it) {
             const AstNode* nodep = it->second->nodep();
             if (nodep && (!matcherp || matcherp->nodeMatch(nodep))) {
                 spellerp->pushCandidate(nodep->prettyName());
@@ -197,13 +227,13 @@ public:
     void importFromPackage(VSymGraph* graphp, const VSymEnt* srcp, const string& id_or_star) {
         // Import tokens from source symbol table into this symbol table
         if (id_or_star != "*") {
-            IdNameMap::const_iterator it = srcp->m_idNameMap.find(id_or_star);
-            if (it != srcp->m_idNameMap.end()) {
-                importOneSymbol(graphp, it->first, it->second);
+            if (VSymEnt* symp = srcp->findIdFlat(id_or_star)) {
+                importOneSymbol(graphp, id_or_star, symp);
             }
         } else {
-            for (IdNameMap::const_iterator it = srcp->m_idNameMap.begin();
-                 it != srcp->m_idNameMap.end(); ++it) {
+            IdNameList ids;
+            srcp->sortedIds(ids);
+            for (IdNameList::const_iterator it = ids.begin(); it != ids.end(); ++it) {
                 importOneSymbol(graphp, it->first, it->second);
             }
         }
@@ -211,13 +241,13 @@ public:
     void exportFromPackage(VSymGraph* graphp, const VSymEnt* srcp, const string& id_or_star) {
         // Export tokens from source symbol table into this symbol table
         if (id_or_star != "*") {
-            IdNameMap::const_iterator it = srcp->m_idNameMap.find(id_or_star);
-            if (it != srcp->m_idNameMap.end()) {
-                exportOneSymbol(graphp, it->first, it->second);
+            if (VSymEnt* symp = srcp->findIdFlat(id_or_star)) {
+                exportOneSymbol(graphp, id_or_star, symp);
             }
         } else {
-            for (IdNameMap::const_iterator it = srcp->m_idNameMap.begin();
-                 it != srcp->m_idNameMap.end(); ++it) {
+            IdNameList ids;
+            srcp->sortedIds(ids);
+            for (IdNameList::const_iterator it = ids.begin(); it != ids.end(); ++it) {
                 exportOneSymbol(graphp, it->first, it->second);
             }
         }
@@ -228,12 +258,16 @@ public:
             VSymEnt* symp = it->second;
             if (!symp->exported()) symp->exported(true);
         }
+        for (UnnamedList::const_iterator it = m_unnamed.begin(); it != m_unnamed.end(); ++it) {
+            if (!(*it)->exported()) (*it)->exported(true);
+        }
     }
     void importFromIface(VSymGraph* graphp, const VSymEnt* srcp, bool onlyUnmodportable = false) {
         // Import interface tokens from source symbol table into this symbol table, recursively
         UINFO(9, "     importIf  se"<<cvtToHex(this)<<" from se"<<cvtToHex(srcp)<<endl);
-        for (IdNameMap::const_iterator it = srcp->m_idNameMap.begin();
-             it != srcp->m_idNameMap.end(); ++it) {
+        IdNameList ids;
+        srcp->sortedIds(ids);
+        for (IdNameList::const_iterator it = ids.begin(); it != ids.end(); ++it) {
             const string& name = it->first;
             VSymEnt* subSrcp = it->second;
             const AstVar* varp = VN_CAST(subSrcp->nodep(), Var);
@@ -248,7 +282,9 @@ public:
     void cellErrorScopes(AstNode* lookp, string prettyName="") {
         if (prettyName=="") prettyName = lookp->prettyName();
         string scopes;
-        for (IdNameMap::iterator it = m_idNameMap.begin(); it!=m_idNameMap.end(); ++it) {
+        IdNameList ids;
+        sortedIds(ids);
+        for (IdNameList::const_iterator it = ids.begin(); it != ids.end(); ++it) {
             AstNode* nodep = it->second->nodep();
             if (VN_IS(nodep, Cell)
                 || (VN_IS(nodep, Module) && VN_CAST(nodep, Module)->isTop())) {
@@ -22,6 +22,8 @@
 //      Count # of input bits and # of output bits, and # of statements
 //      If high # of statements relative to inpbits*outbits,
 //      replace with lookup table
+//      If many inputs give the same outputs, instead make a table of
+//      row numbers, indexing tables of just the distinct output rows
 //
 //*************************************************************************
 
@@ -37,6 +39,8 @@
 #include <cmath>
 #include <cstdarg>
 #include <deque>
+#include <map>
+#include <vector>
 
 //######################################################################
 // Table class functions
@@ -46,6 +50,8 @@ static const double TABLE_MAX_BYTES = 1*1024*1024;  // 1MB is max table size (be
 static const double TABLE_TOTAL_BYTES = 64*1024*1024;  // 64MB is close to max memory of some systems (256MB or so), so don't get out of control
 static const double TABLE_SPACE_TIME_MULT = 8;  // Worth 8 bytes of data to replace a instruction
 static const int TABLE_MIN_NODE_COUNT = 32;  // If < 32 instructions, not worth the effort
+static const double TABLE_DEDUP_MAX_ENTRIES = 64*1024;  // Max inputs to simulate to find duplicate rows
+static const double TABLE_DEDUP_GAIN = 2;  // Row table must be this much smaller to be worth a second lookup
 
 //######################################################################
 
@@ -76,6 +82,7 @@ private:
     // STATE
     double      m_totalBytes;           // Total bytes in tables created
     VDouble0    m_statTablesCre;        // Statistic tracking
+    VDouble0    m_statTablesRows;       // Statistic tracking
 
     //  State cleared on each module
     AstNodeModule*      m_modp;         // Current MODULE
@@ -93,8 +100,13 @@ private:
     std::deque<AstVarScope*> m_outVarps;        // Output variable list
     std::deque<bool>    m_outNotSet;            // True if output variable is not set at some point
 
+    double      m_tableTime;            // Bytes of instructions the table replaces
+    bool        m_needRows;             // Only fits if duplicate rows are removed
+
     // When creating a table
     std::deque<AstVarScope*> m_tableVarps;      // Table being created
+    std::vector<uint32_t> m_inputRows;  // Row number for each input value
+    std::vector<AstConst*> m_rowValues;  // Each output of each row, NULL if not set
 
     // METHODS
     VL_DEBUG_FUNC;  // Declare debug()
@@ -125,13 +137,22 @@ private:
         double bytesPerInst = 4;
         double time = ((chkvis.instrCount()*bytesPerInst + chkvis.dataCount())
                        + 1);  // +1 so won't div by zero
+        m_tableTime = time;
+        // A table of row numbers may fit where a full table doesn't;
+        // we'll only know once we've simulated and found the distinct rows
+        double entries = pow(static_cast<double>(2.0), static_cast<double>(m_inWidth));
+        double rowSpace = entries * indexBytes();
+        m_needRows = (space > TABLE_MAX_BYTES || space > time * TABLE_SPACE_TIME_MULT);
         if (chkvis.instrCount() < TABLE_MIN_NODE_COUNT) {
             chkvis.clearOptimizable(nodep, "Table has too few nodes involved");
         }
-        if (space > TABLE_MAX_BYTES) {
+        if (m_needRows && entries > TABLE_DEDUP_MAX_ENTRIES) {
+            chkvis.clearOptimizable(nodep, "Table has too many inputs to compress");
+        }
+        if (rowSpace > TABLE_MAX_BYTES) {
             chkvis.clearOptimizable(nodep, "Table takes too much space");
         }
-        if (space > time * TABLE_SPACE_TIME_MULT) {
+        if (rowSpace > time * TABLE_SPACE_TIME_MULT) {
             chkvis.clearOptimizable(nodep, "Table has bad tradeoff");
         }
         if (m_totalBytes > TABLE_TOTAL_BYTES) {
@@ -147,10 +168,20 @@ private:
               <<": "<<nodep<<endl);
         if (chkvis.optimizable()) {
             UINFO(3, " Table Optimize spacetime="<<(space/time)<<" "<<nodep<<endl);
-            m_totalBytes += space;
         }
         return chkvis.optimizable();
     }
+    int indexBytes() const {
+        // Bytes in each element of the row number table
+        return m_inWidth <= 8 ? 1 : m_inWidth <= 16 ? 2 : 4;
+    }
+    double rowBytes() const {
+        // Bytes to store one row of outputs and its change mask
+        // (Same estimate of the change mask as treeTest)
+        size_t chgWidth = m_outVarps.size();
+        if (chgWidth<8) chgWidth = 8;
+        return static_cast<double>(m_outWidth + chgWidth);
+    }
 
 public:
     void simulateVarRefCb(AstVarRef* nodep) {
@@ -171,8 +202,32 @@ public:
 private:
     void createTable(AstAlways* nodep) {
         // We've determined this table of nodes is optimizable, do it.
+        simulateTable(nodep);
+
+        // Pick full table, or row number table and tables of the distinct rows.
+        // Compare cache footprint, as a second dependent load is cheap
+        // compared to missing the cache on a larger table.
+        double entries = m_inputRows.size();
+        double rows = m_rowValues.size() / m_outVarps.size();
+        double space = entries * rowBytes();
+        double rowSpace = entries * indexBytes() + rows * rowBytes();
+        bool useRows = m_needRows || (rowSpace * TABLE_DEDUP_GAIN < space);
+        if (useRows) {
+            if (rowSpace > TABLE_MAX_BYTES || rowSpace > m_tableTime * TABLE_SPACE_TIME_MULT) {
+                UINFO(4, "  Table rows="<<rows<<" still too large, "<<rowSpace
+                      <<" bytes: "<<nodep<<endl);
+                tableCleanup();
+                return;
+            }
+            space = rowSpace;
+            ++m_statTablesRows;
+        }
+        UINFO(4, "  Table rows="<<rows<<" of "<<entries<<" useRows="<<useRows
+              <<" bytes="<<space<<": "<<nodep<<endl);
+        m_totalBytes += space;
         ++m_modTables;
         ++m_statTablesCre;
+        uint32_t tableEntries = useRows ? static_cast<uint32_t>(rows) : (VL_MASK_I(m_inWidth) + 1);
 
         // Index into our table
         AstVar* indexVarp = new AstVar(nodep->fileline(), AstVarType::BLOCKTEMP,
@@ -188,7 +243,7 @@ private:
             = new AstUnpackArrayDType(fl,
                                       nodep->findBitDType(m_outVarps.size(),
                                                           m_outVarps.size(), AstNumeric::UNSIGNED),
-                                      new AstRange(fl, VL_MASK_I(m_inWidth), 0));
+                                      new AstRange(fl, tableEntries - 1, 0));
         v3Global.rootp()->typeTablep()->addTypesp(dtypep);
         AstVar* chgVarp
             = new AstVar(fl, AstVarType::MODULETEMP,
@@ -200,9 +255,10 @@ private:
         AstVarScope* chgVscp = new AstVarScope(chgVarp->fileline(), m_scopep, chgVarp);
         m_scopep->addVarp(chgVscp);
 
-        createTableVars(nodep);
+        createTableVars(nodep, tableEntries);
         AstNode* stmtsp = createLookupInput(nodep, indexVscp);
-        createTableValues(nodep, chgVscp);
+        if (useRows) createRowLookup(nodep, stmtsp, indexVscp);
+        createTableValues(nodep, chgVscp, useRows);
 
         // Collapse duplicate tables
         chgVscp = findDuplicateTable(chgVscp);
@@ -224,10 +280,19 @@ private:
         }
 
         // Cleanup internal structures
+        tableCleanup();
+    }
+    void tableCleanup() {
         m_tableVarps.clear();
+        m_inputRows.clear();
+        for (std::vector<AstConst*>::iterator it = m_rowValues.begin();
+             it != m_rowValues.end(); ++it) {
+            if (*it) (*it)->deleteTree();
+        }
+        m_rowValues.clear();
     }
 
-    void createTableVars(AstNode* nodep) {
+    void createTableVars(AstNode* nodep, uint32_t tableEntries) {
         // Create table for each output
         typedef std::map<string,int> NameCounts;
         NameCounts namecounts;
@@ -238,7 +303,7 @@ private:
             FileLine* fl = nodep->fileline();
             AstNodeArrayDType* dtypep
                 = new AstUnpackArrayDType(fl, outvarp->dtypep(),
-                                          new AstRange(fl, VL_MASK_I(m_inWidth), 0));
+                                          new AstRange(fl, tableEntries - 1, 0));
             v3Global.rootp()->typeTablep()->addTypesp(dtypep);
             string name = "__Vtable"+cvtToStr(m_modTables)+"_"+outvarp->name();
             NameCounts::iterator nit = namecounts.find(name);
@@ -279,8 +344,34 @@ private:
         return stmtsp;
     }
 
-    void createTableValues(AstAlways* nodep, AstVarScope* chgVscp) {
-        // Create table
+    void createRowLookup(AstAlways* nodep, AstNode* stmtsp, AstVarScope* indexVscp) {
+        // Table of row numbers; the index becomes the row number
+        FileLine* fl = nodep->fileline();
+        AstNodeArrayDType* dtypep
+            = new AstUnpackArrayDType(fl, indexVscp->varp()->dtypep(),
+                                      new AstRange(fl, VL_MASK_I(m_inWidth), 0));
+        v3Global.rootp()->typeTablep()->addTypesp(dtypep);
+        AstVar* rowVarp = new AstVar(fl, AstVarType::MODULETEMP,
+                                     "__Vtablerow" + cvtToStr(m_modTables), dtypep);
+        rowVarp->isConst(true);
+        rowVarp->isStatic(true);
+        AstInitArray* initp = new AstInitArray(fl, dtypep, NULL);
+        rowVarp->valuep(initp);
+        for (std::vector<uint32_t>::iterator it = m_inputRows.begin();
+             it != m_inputRows.end(); ++it) {
+            initp->addValuep(new AstConst(fl, AstConst::WidthedValue(), m_inWidth, *it));
+        }
+        m_modp->addStmtp(rowVarp);
+        AstVarScope* rowVscp = new AstVarScope(fl, m_scopep, rowVarp);
+        m_scopep->addVarp(rowVscp);
+        rowVscp = findDuplicateTable(rowVscp);
+        stmtsp->addNext(new AstAssign(fl, new AstVarRef(fl, indexVscp, true),
+                                      new AstArraySel(fl, new AstVarRef(fl, rowVscp, false),
+                                                      new AstVarRef(fl, indexVscp, false))));
+    }
+
+    void simulateTable(AstAlways* nodep) {
+        // Simulate each input value, recording each distinct row of outputs
         // There may be a simulation path by which the output doesn't change value.
         // We could bail on these cases, or we can have a "change it" boolean.
         // We've chosen the latter route, since recirc is common in large FSMs.
@@ -288,7 +379,8 @@ private:
              it != m_outVarps.end(); ++it) {
             m_outNotSet.push_back(false);
         }
-        uint32_t inValueNextInitArray = 0;
+        typedef std::map<string,uint32_t> RowNums;
+        RowNums rowNums;
         TableSimulateVisitor simvis (this);
         for (uint32_t inValue=0; inValue <= VL_MASK_I(m_inWidth); inValue++) {
             // Make a new simulation structure so we can set new input values
@@ -320,40 +412,70 @@ private:
                         "Optimizable cleared, even though earlier test run said not: "
                         <<simvis.whyNotMessage());
 
-            // If a output changed, add it to table
+            // Find if this row of outputs was seen before
+            string key;
+            for (std::deque<AstVarScope*>::iterator it = m_outVarps.begin();
+                 it != m_outVarps.end(); ++it) {
+                V3Number* outnump = simvis.fetchOutNumberNull(*it);
+                key += (outnump ? outnump->ascii() : "-") + ",";
+            }
+            RowNums::iterator rit = rowNums.find(key);
+            if (rit != rowNums.end()) {
+                m_inputRows.push_back(rit->second);
+                continue;
+            }
+            uint32_t rowNum = rowNums.size();
+            rowNums.insert(make_pair(key, rowNum));
+            m_inputRows.push_back(rowNum);
+
             int outnum = 0;
-            V3Number outputChgMask (nodep, m_outVarps.size(), 0);
             for (std::deque<AstVarScope*>::iterator it = m_outVarps.begin();
                  it != m_outVarps.end(); ++it) {
                 AstVarScope* outvscp = *it;
                 V3Number* outnump = simvis.fetchOutNumberNull(outvscp);
-                AstNode* setp;
                 if (!outnump) {
                     UINFO(8,"   Output "<<outvscp->name()<<" never set\n");
                     m_outNotSet[outnum] = true;
+                    m_rowValues.push_back(NULL);
+                } else {
+                    UINFO(8,"   Output "<<outvscp->name()<<" = "<<*outnump<<endl);
+                    m_rowValues.push_back(new AstConst(outnump->fileline(), *outnump));
+                }
+                outnum++;
+            }
+        }  // each value
+    }
+
+    void createTableValues(AstAlways* nodep, AstVarScope* chgVscp, bool useRows) {
+        // Create table, from each row if using row numbers, else from each input value
+        size_t outputs = m_outVarps.size();
+        size_t entries = useRows ? m_rowValues.size() / outputs : m_inputRows.size();
+        for (size_t entry = 0; entry < entries; ++entry) {
+            size_t row = useRows ? entry : m_inputRows[entry];
+            int outnum = 0;
+            V3Number outputChgMask (nodep, outputs, 0);
+            for (std::deque<AstVarScope*>::iterator it = m_outVarps.begin();
+                 it != m_outVarps.end(); ++it) {
+                AstVarScope* outvscp = *it;
+                AstConst* valuep = m_rowValues[row * outputs + outnum];
+                AstNode* setp;
+                if (!valuep) {
                     // Value in table is arbitrary, but we need something
                     setp = new AstConst(outvscp->fileline(),
                                         AstConst::WidthedValue(), outvscp->width(), 0);
                 } else {
-                    UINFO(8,"   Output "<<outvscp->name()<<" = "<<*outnump<<endl);
-                    //  m_tableVarps[inValue] = num;
                     // Mark changed bit, too
                     outputChgMask.setBit(outnum, 1);
-                    setp = new AstConst(outnump->fileline(), *outnump);
+                    setp = valuep->cloneTree(false);
                 }
-                // Note InitArray requires us to have the values in inValue order
+                // Note InitArray requires us to have the values in entry order
                 VN_CAST(m_tableVarps[outnum]->varp()->valuep(), InitArray)->addValuep(setp);
                 outnum++;
             }
-
-            {   // Set changed table
-                UASSERT_OBJ(inValue == inValueNextInitArray, nodep,
-                            "InitArray requires us to have the values in inValue order");
-                inValueNextInitArray++;
-                AstNode* setp = new AstConst(nodep->fileline(), outputChgMask);
-                VN_CAST(chgVscp->varp()->valuep(), InitArray)->addValuep(setp);
-            }
-        }  // each value
+            // Set changed table
+            AstNode* setp = new AstConst(nodep->fileline(), outputChgMask);
+            VN_CAST(chgVscp->varp()->valuep(), InitArray)->addValuep(setp);
+        }
     }
 
     AstVarScope* findDuplicateTable(AstVarScope* vsc1p) {
@@ -466,10 +588,13 @@ public:
         m_inWidth = 0;
         m_outWidth = 0;
         m_totalBytes = 0;
+        m_tableTime = 0;
+        m_needRows = false;
         iterate(nodep);
     }
     virtual ~TableVisitor() {
         V3Stats::addStat("Optimizations, Tables created", m_statTablesCre);
+        V3Stats::addStat("Optimizations, Tables of distinct rows", m_statTablesRows);
     }
 };
 
@@ -68,6 +68,7 @@
 #include "V3Name.h"
 #include "V3Order.h"
 #include "V3Os.h"
+#include "V3PackBits.h"
 #include "V3Param.h"
 #include "V3Parse.h"
 #include "V3ParseSym.h"
@@ -75,6 +76,7 @@
 #include "V3PreShell.h"
 #include "V3Premit.h"
 #include "V3ProtectLib.h"
+#include "V3Quiesce.h"
 #include "V3Reloop.h"
 #include "V3Scope.h"
 #include "V3Scoreboard.h"
@@ -158,6 +160,14 @@ void V3Global::dumpCheckGlobalTree(const string& stagename, int newNumber, bool
     if (v3Global.opt.stats()) V3Stats::statsStage(stagename);
 }
 
+static void releaseFreeMemory() {
+    // The passes before each call create many nodes then delete most of them
+    size_t bytes = AstNode::releaseFreeSlabs();
+    if (v3Global.opt.stats()) {
+        V3Stats::addStatPerf("Memory, AST slabs released (MB)", bytes / 1024.0 / 1024.0);
+    }
+}
+
 //######################################################################
 
 void process() {
@@ -192,6 +202,7 @@ void process() {
     // Remove any modules that were parameterized and are no longer referenced.
     V3Dead::deadifyModules(v3Global.rootp());
     v3Global.checkTree();
+    releaseFreeMemory();
 
     // Calculate and check widths, edit tree to TRUNC/EXTRACT any width mismatches
     V3Width::width(v3Global.rootp());
@@ -365,6 +376,7 @@ void process() {
         // Remove unused vars
         V3Const::constifyAll(v3Global.rootp());
         V3Dead::deadifyAllScoped(v3Global.rootp());
+        releaseFreeMemory();
 
         // Clock domain crossing analysis
         if (v3Global.opt.cdc()) {
@@ -409,6 +421,11 @@ void process() {
             V3LifePost::lifepostAll(v3Global.rootp());
         }
 
+        // Pack single bit signals into words; V3Const then merges their logic
+        if (v3Global.opt.oPackBits()) {
+            V3PackBits::packBitsAll(v3Global.rootp());
+        }
+
         // Remove unused vars
         V3Const::constifyAll(v3Global.rootp());
         V3Dead::deadifyAllScoped(v3Global.rootp());
@@ -416,6 +433,11 @@ void process() {
         // Detect change loop
         V3Changed::changedAll(v3Global.rootp());
 
+        // Skip expensive combo logic whose inputs have not changed
+        if (v3Global.opt.quiesceMinCost()) {
+            V3Quiesce::quiesceAll(v3Global.rootp());
+        }
+
         // Create tracing logic, since we ripped out some signals the user might want to trace
         // Note past this point, we presume traced variables won't move between CFuncs
         // (It's OK if untraced temporaries move around, or vars
@@ -490,6 +512,7 @@ void process() {
 
         V3Dead::deadifyAll(v3Global.rootp());
     }
+    releaseFreeMemory();
 
     if (!v3Global.opt.lintOnly()
         && !v3Global.opt.xmlOnly()
@@ -0,0 +1,27 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+scenarios(simulator => 1);
+
+compile(
+    verilator_flags2 => ['--Ox'],
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+if ($Self->{vlt_all}) {
+    file_grep("$Self->{obj_dir}/$Self->{VM_PREFIX}.cpp", qr/VL_AND_W/);
+    file_grep("$Self->{obj_dir}/$Self->{VM_PREFIX}.cpp", qr/VL_XOR_W/);
+    file_grep("$Self->{obj_dir}/$Self->{VM_PREFIX}.cpp", qr/VL_OR_W/);
+}
+
+ok(1);
+1;
@@ -0,0 +1,57 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2020 by Wilson Snyder.
+//
+// 512-bit AND/XOR/OR/NOT kernel, updating its result in place.  With
+// --Ox these go through the VL_*_W helpers; run with driver.pl
+// --benchmark=<cycles> to time them.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   localparam last_cyc =
+`ifdef TEST_BENCHMARK
+        `TEST_BENCHMARK;
+`else
+        100;
+`endif
+
+   integer      cyc = 0;
+   reg [511:0]  a = {16{32'h12345678}};
+   reg [511:0]  b = {16{32'h9abcdef0}};
+   reg [511:0]  c = {16{32'h0f1e2d3c}};
+   reg [511:0]  x = 512'h0;
+   reg [511:0]  xp = 512'h0;
+   reg [31:0]   exp;
+   integer      i;
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      x = x ^ (a & b);
+      x = x | c;
+      x = ~x ^ a;
+      // Check each word against narrow arithmetic
+      if (cyc < 100) begin
+         for (i = 0; i < 16; i = i + 1) begin
+            exp = ~(xp[i*32 +: 32] ^ (a[i*32 +: 32] & b[i*32 +: 32])
+                    | c[i*32 +: 32]) ^ a[i*32 +: 32];
+            if (x[i*32 +: 32] !== exp) begin
+               $write("%%Error: cyc=%0d x[%0d]=%x exp=%x\n", cyc, i, x[i*32 +: 32], exp);
+               $stop;
+            end
+         end
+      end
+      xp = x;
+      a <= {a[478:0], a[511:479] ^ x[32:0]};
+      b <= {b[510:0], b[511] ^ b[300]};
+      c <= c ^ {x[255:0], x[511:256]};
+      if (cyc == last_cyc) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
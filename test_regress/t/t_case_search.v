@@ -0,0 +1,192 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2020 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer      cyc = 0;
+   logic [31:0] opcode;
+   logic [7:0]  decode;
+
+   localparam N = 12;
+   integer             idx = 0;
+   logic signed [19:0] sel_s;
+   logic [7:0]         dec_s;
+   logic signed [19:0] s_in [0:N-1];
+   logic [7:0]         s_exp [0:N-1];
+   logic [63:0]        sel_w;
+   logic [7:0]         dec_w;
+   logic [63:0]        w_in [0:N-1];
+   logic [7:0]         w_exp [0:N-1];
+   logic [31:0]        sel_c;
+   logic [7:0]         dec_c;
+   logic [31:0]        c_in [0:N-1];
+   logic [7:0]         c_exp [0:N-1];
+
+   initial begin
+      s_in[0] = 20'shfffff;  s_exp[0] = 8'd1;
+      s_in[1] = 20'shffffe;  s_exp[1] = 8'd2;
+      s_in[2] = 20'shb6c20;  s_exp[2] = 8'd3;
+      s_in[3] = 20'sh00000;  s_exp[3] = 8'd4;
+      s_in[4] = 20'sh00001;  s_exp[4] = 8'd5;
+      s_in[5] = 20'sh11170;  s_exp[5] = 8'd6;
+      s_in[6] = 20'sh7ffff;  s_exp[6] = 8'd7;
+      s_in[7] = 20'sh80000;  s_exp[7] = 8'd8;
+      s_in[8] = 20'sh00002;  s_exp[8] = 8'd0;
+      s_in[9] = 20'shfff00;  s_exp[9] = 8'd0;
+      s_in[10] = 20'sh7fffe; s_exp[10] = 8'd0;
+      s_in[11] = 20'sh80001; s_exp[11] = 8'd0;
+
+      w_in[0] = 64'h0000_0000_0000_0010;  w_exp[0] = 8'd1;
+      w_in[1] = 64'h0000_0001_0000_0000;  w_exp[1] = 8'd2;
+      w_in[2] = 64'h7fff_ffff_ffff_ffff;  w_exp[2] = 8'd3;
+      w_in[3] = 64'h8000_0000_0000_0000;  w_exp[3] = 8'd4;
+      w_in[4] = 64'hffff_ffff_ffff_ffff;  w_exp[4] = 8'd5;
+      w_in[5] = 64'h0000_0000_ffff_ffff;  w_exp[5] = 8'd6;
+      w_in[6] = 64'h1234_5678_9abc_def0;  w_exp[6] = 8'd7;
+      w_in[7] = 64'hdead_beef_0000_0001;  w_exp[7] = 8'd8;
+      w_in[8] = 64'h0000_0000_0000_0000;  w_exp[8] = 8'd9;
+      w_in[9] = 64'h0000_0000_0000_0011;  w_exp[9] = 8'd0;
+      w_in[10] = 64'hffff_ffff_ffff_fffe; w_exp[10] = 8'd0;
+      w_in[11] = 64'h8000_0000_0000_0001; w_exp[11] = 8'd0;
+
+      c_in[0] = 32'h0000_0001;  c_exp[0] = 8'd1;
+      c_in[1] = 32'hf000_0000;  c_exp[1] = 8'd1;
+      c_in[2] = 32'h0000_0010;  c_exp[2] = 8'd2;
+      c_in[3] = 32'h0000_0020;  c_exp[3] = 8'd3;
+      c_in[4] = 32'h0000_0030;  c_exp[4] = 8'd4;
+      c_in[5] = 32'h0000_0040;  c_exp[5] = 8'd5;
+      c_in[6] = 32'h0000_0050;  c_exp[6] = 8'd6;
+      c_in[7] = 32'h0000_0060;  c_exp[7] = 8'd7;
+      c_in[8] = 32'h0000_0000;  c_exp[8] = 8'd0;
+      c_in[9] = 32'h0000_0002;  c_exp[9] = 8'd0;
+      c_in[10] = 32'hffff_ffff; c_exp[10] = 8'd0;
+      c_in[11] = 32'h0000_0070; c_exp[11] = 8'd0;
+   end
+
+   // Sparse wide decoder, lowered to a binary search
+   always_comb begin
+      case (opcode)
+        32'h0000_0013: decode = 8'd1;
+        32'h0000_0033: decode = 8'd2;
+        32'h0000_0063: decode = 8'd3;
+        32'h0000_006f: decode = 8'd4;
+        32'h0000_0067: decode = 8'd5;
+        32'h0010_0073,
+        32'h0000_0073: decode = 8'd6;
+        32'h0200_0033: decode = 8'd7;
+        32'h4000_0033: decode = 8'd8;
+        32'h8000_0000: decode = 8'd9;
+        32'hffff_ffff: decode = 8'd10;
+        32'h1234_5678: decode = 8'd12;
+        default: decode = 8'd0;
+      endcase
+   end
+
+   // Signed selector, searched as unsigned bit patterns
+   always_comb begin
+      case (sel_s)
+        20'shfffff: dec_s = 8'd1;
+        20'shffffe: dec_s = 8'd2;
+        20'shb6c20: dec_s = 8'd3;
+        20'sh00000: dec_s = 8'd4;
+        20'sh00001: dec_s = 8'd5;
+        20'sh11170: dec_s = 8'd6;
+        20'sh7ffff: dec_s = 8'd7;
+        20'sh80000: dec_s = 8'd8;
+        default: dec_s = 8'd0;
+      endcase
+   end
+
+   // Widest selector searched
+   always_comb begin
+      case (sel_w)
+        64'h0000_0000_0000_0010: dec_w = 8'd1;
+        64'h0000_0001_0000_0000: dec_w = 8'd2;
+        64'h7fff_ffff_ffff_ffff: dec_w = 8'd3;
+        64'h8000_0000_0000_0000: dec_w = 8'd4;
+        64'hffff_ffff_ffff_ffff: dec_w = 8'd5;
+        64'h0000_0000_ffff_ffff: dec_w = 8'd6;
+        64'h0000_0000_0000_0010: dec_w = 8'd99;  // Duplicate, the first item wins
+        64'h1234_5678_9abc_def0: dec_w = 8'd7;
+        64'hdead_beef_0000_0001: dec_w = 8'd8;
+        64'h0000_0000_0000_0000: dec_w = 8'd9;
+        default: dec_w = 8'd0;
+      endcase
+   end
+
+   // Not searched: the first item's values are in different leaves,
+   // and its body is too costly to clone into each
+   always_comb begin
+      case (sel_c)
+        32'h0000_0001,
+        32'hf000_0000: begin
+           if (sel_c == 32'h0000_1234) $write("never\n");
+           if (sel_c == 32'h0000_1235) $write("never\n");
+           dec_c = 8'd1;
+        end
+        32'h0000_0010: dec_c = 8'd2;
+        32'h0000_0020: dec_c = 8'd3;
+        32'h0000_0030: dec_c = 8'd4;
+        32'h0000_0040: dec_c = 8'd5;
+        32'h0000_0050: dec_c = 8'd6;
+        32'h0000_0060: dec_c = 8'd7;
+        default: dec_c = 8'd0;
+      endcase
+   end
+
+   always @(posedge clk) begin
+      if (cyc > 0) begin
+         if (dec_s !== s_exp[idx] || dec_w !== w_exp[idx] || dec_c !== c_exp[idx]) begin
+            $write("%%Error: idx=%0d sel_s=%x dec_s=%0d sel_w=%x dec_w=%0d sel_c=%x dec_c=%0d\n",
+                   idx, sel_s, dec_s, sel_w, dec_w, sel_c, dec_c);
+            $stop;
+         end
+      end
+      idx <= cyc % N;
+      sel_s <= s_in[cyc % N];
+      sel_w <= w_in[cyc % N];
+      sel_c <= c_in[cyc % N];
+   end
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      case (cyc)
+        0: opcode <= 32'h0000_0013;
+        1: opcode <= 32'h0000_0033;
+        2: opcode <= 32'h0000_0063;
+        3: opcode <= 32'h0000_006f;
+        4: opcode <= 32'h0000_0067;
+        5: opcode <= 32'h0010_0073;
+        6: opcode <= 32'h0000_0073;
+        7: opcode <= 32'h0200_0033;
+        8: opcode <= 32'h4000_0033;
+        9: opcode <= 32'h8000_0000;
+        10: opcode <= 32'hffff_ffff;
+        11: opcode <= 32'h1234_5678;
+        12: opcode <= 32'h0000_0000;
+        13: opcode <= 32'h0000_0034;
+        14: opcode <= 32'h7fff_ffff;
+        default: opcode <= 32'hffff_fffe;
+      endcase
+      if (cyc > 0) begin
+         if (decode !== (cyc == 1 ? 8'd1 : cyc == 2 ? 8'd2 : cyc == 3 ? 8'd3
+                         : cyc == 4 ? 8'd4 : cyc == 5 ? 8'd5 : cyc == 6 ? 8'd6
+                         : cyc == 7 ? 8'd6 : cyc == 8 ? 8'd7 : cyc == 9 ? 8'd8
+                         : cyc == 10 ? 8'd9 : cyc == 11 ? 8'd10 : cyc == 12 ? 8'd12
+                         : 8'd0)) begin
+            $write("%%Error: cyc=%0d opcode=%x decode=%0d\n", cyc, opcode, decode);
+            $stop;
+         end
+      end
+      if (cyc == 20) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
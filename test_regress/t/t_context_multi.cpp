@@ -0,0 +1,77 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2020 by Wilson Snyder.
+
+#include <verilated.h>
+#include "Vt_context_multi.h"
+
+#include <vector>
+
+double sc_time_stamp() { return 0; }  // Unused, as each model has a context
+
+typedef std::vector<vluint32_t> Randoms;
+
+static void tick(Vt_context_multi* topp, VerilatedContext* contextp, Randoms& randoms) {
+    if (contextp->gotFinish()) return;
+    topp->clk = 0;
+    topp->eval();
+    contextp->timeInc(1);
+    topp->clk = 1;
+    topp->eval();
+    randoms.push_back(topp->rnd);
+}
+
+int main(int argc, char* argv[]) {
+    static const char* argsa[] = {"a", "+limit=3"};
+    static const char* argsb[] = {"b", "+limit=5"};
+    VerilatedContext contexta;
+    VerilatedContext contextb;
+    contexta.commandArgs(2, argsa);
+    contextb.commandArgs(2, argsb);
+    contexta.randSeed(11);
+    contextb.randSeed(22);
+
+    Vt_context_multi* ap = new Vt_context_multi(&contexta, "a");
+    Vt_context_multi* bp = new Vt_context_multi(&contextb, "b");
+
+    // Interleave the models on one thread; each sees only its own context
+    Randoms randomsa;
+    Randoms randomsb;
+    while (!contexta.gotFinish() || !contextb.gotFinish()) {
+        tick(ap, &contexta, randomsa);
+        tick(bp, &contextb, randomsb);
+        if (contextb.time() > 100) vl_fatal(__FILE__, __LINE__, "main", "Timeout");
+    }
+    if (contexta.time() != 3 || contextb.time() != 5) {
+        vl_fatal(__FILE__, __LINE__, "main", "Models did not finish independently");
+    }
+    if (Verilated::gotFinish()) vl_fatal(__FILE__, __LINE__, "main", "Global $finish set");
+
+    ap->final();
+    bp->final();
+    delete ap;
+    delete bp;
+
+    // Each model's random sequence comes from its own seed, so running
+    // with model b's seed alone reproduces b, and differs from a
+    VerilatedContext contextc;
+    contextc.commandArgs(2, argsb);
+    contextc.randSeed(22);
+    Vt_context_multi* cp = new Vt_context_multi(&contextc, "c");
+    Randoms randomsc;
+    while (!contextc.gotFinish()) tick(cp, &contextc, randomsc);
+    cp->final();
+    delete cp;
+    if (randomsc != randomsb) {
+        vl_fatal(__FILE__, __LINE__, "main", "Seeded model not reproducible");
+    }
+    if (Randoms(randomsb.begin(), randomsb.begin() + randomsa.size()) == randomsa) {
+        vl_fatal(__FILE__, __LINE__, "main", "Models with different seeds match");
+    }
+
+    VL_PRINTF("*-* All Finished *-*\n");
+    return 0;
+}
@@ -0,0 +1,31 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2020 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Outputs
+   rnd,
+   // Inputs
+   clk
+   );
+   input clk;
+   output reg [31:0] rnd;
+
+   integer cyc = 0;
+   integer limit;
+
+   initial begin
+      if (!$value$plusargs("limit=%d", limit)) $stop;
+   end
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      // From the context's random seed
+      rnd <= $urandom;
+      if (cyc == limit - 1) begin
+         $write("[%0t] limit=%0d\n", $time, limit);
+         $finish;
+      end
+   end
+endmodule
@@ -0,0 +1,72 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2020 by Wilson Snyder.
+
+#include <verilated.h>
+#include "svdpi.h"
+#include "Vt_context_scope.h"
+#include "Vt_context_scope__Dpi.h"
+
+// No sc_time_stamp(), as every model has a context
+
+static Vt_context_scope* newModel(VerilatedContext* contextp, int id) {
+    // Every model has the same name; each context has its own scopes
+    Vt_context_scope* topp = new Vt_context_scope(contextp, "top");
+    VerilatedContextGuard guard(contextp);
+    svScope scope = svGetScopeFromName("top.t");
+    if (!scope) vl_fatal(__FILE__, __LINE__, "main", "No scope in context");
+    svSetScope(scope);
+    set_id(id);
+    return topp;
+}
+
+static int getId(VerilatedContext* contextp) {
+    VerilatedContextGuard guard(contextp);
+    svSetScope(svGetScopeFromName("top.t"));
+    return get_id();
+}
+
+static void tick(Vt_context_scope* topp, VerilatedContext* contextp) {
+    topp->clk = 0;
+    topp->eval();
+    contextp->timeInc(1);
+    topp->clk = 1;
+    topp->eval();
+}
+
+int main(int argc, char* argv[]) {
+    VerilatedContext contexta;
+    VerilatedContext contextb;
+    Vt_context_scope* ap = newModel(&contexta, 1);
+    Vt_context_scope* bp = newModel(&contextb, 2);
+
+    if (svGetScopeFromName("top.t")) {
+        vl_fatal(__FILE__, __LINE__, "main", "Context's scope found outside the context");
+    }
+    if (getId(&contexta) != 1 || getId(&contextb) != 2) {
+        vl_fatal(__FILE__, __LINE__, "main", "Models of the same name share a scope");
+    }
+
+    for (int cyc = 0; cyc < 2; ++cyc) {
+        tick(ap, &contexta);
+        tick(bp, &contextb);
+    }
+    if (Verilated::threadContextp()) {
+        vl_fatal(__FILE__, __LINE__, "main", "Thread context not restored");
+    }
+
+    // Deleting one model leaves the other's scope in place
+    ap->final();
+    delete ap;
+    if (getId(&contextb) != 2) {
+        vl_fatal(__FILE__, __LINE__, "main", "Scope lost when other model deleted");
+    }
+    bp->final();
+    delete bp;
+
+    VL_PRINTF("*-* All Finished *-*\n");
+    return 0;
+}
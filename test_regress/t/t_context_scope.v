@@ -0,0 +1,27 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2020 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   int id;
+
+   export "DPI-C" function set_id;
+   export "DPI-C" function get_id;
+
+   function void set_id(input int value);
+      id = value;
+   endfunction
+   function int get_id();
+      return id;
+   endfunction
+
+   always @ (posedge clk) begin
+      $write("[%0t] %m id=%0d\n", $time, id);
+   end
+endmodule
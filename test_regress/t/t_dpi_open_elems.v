@@ -0,0 +1,34 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// Copyright 2020 by Wilson Snyder. This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+
+`define checkh(gotv,expv) do if ((gotv) !== (expv)) begin $write("%%Error: %s:%0d:  got='h%x exp='h%x\n", `__FILE__,`__LINE__, (gotv), (expv)); $stop; end while(0)
+
+module t (/*AUTOARG*/);
+
+   import "DPI-C" function void dpii_elems_b(input bit [7:0] i [], output bit [7:0] o []);
+   import "DPI-C" function void dpii_elems_w(input bit [95:0] i [], output bit [95:0] o []);
+
+   bit [7:0]  i_b [-2:5];
+   bit [7:0]  o_b [-2:5];
+   bit [95:0] i_w [3:0];
+   bit [95:0] o_w [3:0];
+
+   initial begin
+      for (int a=-2; a<=5; a=a+1) i_b[a] = 8'(a * 7);
+      for (int a=0; a<=3; a=a+1) i_w[a] = {32'(a), 32'h1234_5678, 32'(a * 3)};
+
+      dpii_elems_b(i_b, o_b);
+      dpii_elems_w(i_w, o_w);
+
+      for (int a=-2; a<=5; a=a+1) `checkh(o_b[a], ~i_b[a]);
+      for (int a=0; a<=3; a=a+1) `checkh(o_w[a], ~i_w[a]);
+
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+
+endmodule
@@ -0,0 +1,35 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+//
+// Copyright 2020 by Wilson Snyder. This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License.
+// Version 2.0.
+//
+// Verilator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+//*************************************************************************
+
+#include <vector>
+#include "svdpi.h"
+#include "verilated_dpi.h"
+
+#include "Vt_dpi_open_elems__Dpi.h"
+
+//======================================================================
+
+// Copy all elements with one bulk call each way, inverting in between
+static void _dpii_elems(const svOpenArrayHandle i, const svOpenArrayHandle o) {
+    int words = SV_PACKED_DATA_NELEMS(svSize(i, 0));
+    int elems = svSize(i, 1);
+    std::vector<svBitVecVal> buf(words * elems);
+    vl_svGetBitArrElemsVecVal(&buf[0], i, svLow(i, 1), elems);
+    for (int w = 0; w < words * elems; ++w) buf[w] = ~buf[w];
+    vl_svPutBitArrElemsVecVal(o, &buf[0], svLow(o, 1), elems);
+}
+
+void dpii_elems_b(const svOpenArrayHandle i, const svOpenArrayHandle o) { _dpii_elems(i, o); }
+void dpii_elems_w(const svOpenArrayHandle i, const svOpenArrayHandle o) { _dpii_elems(i, o); }
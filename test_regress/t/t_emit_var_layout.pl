@@ -0,0 +1,36 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+scenarios(vlt => 1);
+
+compile(
+    verilator_flags2 => ["--stats"],
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+my $header = "$Self->{obj_dir}/$Self->{VM_PREFIX}.h";
+# Serial models don't align member groups
+file_grep_not($header, qr/VL_ATTR_ALIGNED\(64\)/);
+file_grep_not($Self->{stats}, qr/mtask footprints cache line aligned/i);
+
+# Members are declared grouped by the first function using them, not in
+# the interleaved source order
+my $order = "";
+foreach my $line (split /\n/, file_contents($header)) {
+    $order .= $1 if $line =~ /\bt__DOT__([ab])\d;/;
+}
+print "Member order: $order\n" if $Self->{verbose};
+($order eq "aaabbb" || $order eq "bbbaaa")
+    or error("Members not grouped by first use, order '$order'\n");
+
+ok(1);
+1;
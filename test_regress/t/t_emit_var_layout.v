@@ -0,0 +1,71 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// Two clock domains, each with its own registers.  The declarations are
+// interleaved so the emitted member order shows how they were grouped.
+// Each domain resets and checks only its own registers.
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2020 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   reg     clk2 = 0;
+
+   reg [31:0] a1;
+   reg [31:0] b1;
+   reg [31:0] a2;
+   reg [31:0] b2;
+   reg [31:0] a3;
+   reg [31:0] b3;
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      clk2 <= ~clk2;
+      if (cyc == 0) begin
+         a1 <= 32'h1;
+         a2 <= 32'h3;
+         a3 <= 32'h5;
+      end
+      else begin
+         a1 <= a1 + 32'h11;
+         a2 <= a2 ^ a1;
+         a3 <= a3 + a2;
+      end
+      if (cyc == 20) begin
+`ifdef TEST_VERBOSE
+         $write("[%0t] a3=%x\n", $time, a3);
+`endif
+         if (a3 !== 32'h0000_08ea) $stop;
+      end
+      else if (cyc == 24) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+   // Rises on even clk edges, after cyc has incremented
+   always @(posedge clk2) begin
+      if (cyc <= 2) begin
+         b1 <= 32'h2;
+         b2 <= 32'h4;
+         b3 <= 32'h6;
+      end
+      else begin
+         b1 <= b1 + 32'h22;
+         b2 <= b2 ^ b1;
+         b3 <= b3 + b2;
+      end
+      if (cyc == 21) begin
+`ifdef TEST_VERBOSE
+         $write("[%0t] b3=%x\n", $time, b3);
+`endif
+         if (b3 !== 32'h0000_024a) $stop;
+      end
+   end
+
+endmodule
@@ -0,0 +1,31 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+scenarios(vltmt => 1);
+
+top_filename("t/t_emit_var_layout.v");
+
+compile(
+    verilator_flags2 => ["--threads 2 --stats"],
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+my $header = "$Self->{obj_dir}/$Self->{VM_PREFIX}.h";
+# Each mtask footprint group starts on a cache line.  The alignment is
+# written as a number, so the layout doesn't depend on the C++ standard.
+file_grep($header, qr/Begin mtask footprint/);
+file_grep($header, qr/VL_ATTR_ALIGNED\(64\) [^;]*t__DOT__[ab]\d;/);
+file_grep_not($header, qr/VL_CACHE_LINE_ALIGNED/);
+file_grep($Self->{stats}, qr/Emit, mtask footprints cache line aligned\s+([1-9]\d*)/i);
+
+ok(1);
+1;
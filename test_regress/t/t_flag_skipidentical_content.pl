@@ -0,0 +1,49 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+scenarios(vlt => 1);
+
+top_filename("$Self->{obj_dir}/$Self->{name}.v");
+
+{
+    # Copy, as we will rewrite it
+    my $wholefile = file_contents("$Self->{t_dir}/t_flag_skipidentical.v");
+    $wholefile =~ s/endmodule/   initial \$display("first");\nendmodule/;
+    write_wholefile($Self->{top_filename}, $wholefile);
+
+    compile();
+
+    my $outfile = "$Self->{obj_dir}/V".$Self->{name}."__Slow.cpp";
+    my @oldstats = stat($outfile);
+    print "Old mtime=",$oldstats[9],"\n";
+    $oldstats[9] or error("No output file found: $outfile\n");
+    file_grep($outfile, qr/first/);
+
+    my @srcstats = stat($Self->{top_filename});
+
+    sleep(1);  # Or else it might take < 1 second to compile and see no diff.
+
+    # New contents of the same size, with the old modification time put back
+    $wholefile =~ s/first/after/;
+    write_wholefile($Self->{top_filename}, $wholefile);
+    utime($srcstats[8], $srcstats[9], $Self->{top_filename})
+        or error("Can't utime $Self->{top_filename}\n");
+
+    compile();
+
+    my @newstats = stat($outfile);
+    print "New mtime=",$newstats[9],"\n";
+
+    ($oldstats[9] != $newstats[9])
+        or error("--skip-identical did not recompile when source contents changed\n");
+    file_grep($outfile, qr/after/);
+}
+
+ok(1);
+1;
@@ -0,0 +1,41 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+scenarios(vlt => 1);
+
+top_filename("$Self->{obj_dir}/$Self->{name}.v");
+
+{
+    # Copy, as we will rewrite it
+    my $wholefile = file_contents("$Self->{t_dir}/t_flag_skipidentical.v");
+    write_wholefile($Self->{top_filename}, $wholefile);
+
+    compile();
+
+    my $outfile = "$Self->{obj_dir}/V".$Self->{name}.".cpp";
+    my @oldstats = stat($outfile);
+    print "Old mtime=",$oldstats[9],"\n";
+    $oldstats[9] or error("No output file found: $outfile\n");
+
+    sleep(1);  # Or else it might take < 1 second to compile and see no diff.
+
+    # Same contents, new timestamps
+    write_wholefile($Self->{top_filename}, $wholefile);
+
+    compile();
+
+    my @newstats = stat($outfile);
+    print "New mtime=",$newstats[9],"\n";
+
+    ($oldstats[9] == $newstats[9])
+        or error("--skip-identical recompiled when only source timestamp changed\n");
+}
+
+ok(1);
+1;
@@ -0,0 +1,80 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2020 by Wilson Snyder.
+
+#include <verilated.h>
+#include <verilated_heavy.h>
+#include <verilated_lanes.h>
+#include "Vt_lanes.h"
+
+#include <string>
+#include <vector>
+
+double sc_time_stamp() { return 0; }  // Unused, as each lane has a context
+
+typedef std::vector<vluint32_t> Randoms;
+
+int main(int argc, char* argv[]) {
+    static const char* argsa[] = {"lanes", "+limit=4"};
+    VerilatedLanes<Vt_lanes> lanes(4, 1, 2, argsa);
+
+    std::vector<Randoms> randoms(lanes.lanes());
+    while (!lanes.gotFinish()) {
+        for (int i = 0; i < lanes.lanes(); ++i) lanes.modelp(i)->clk = 0;
+        lanes.eval();
+        lanes.timeInc(1);
+        for (int i = 0; i < lanes.lanes(); ++i) lanes.modelp(i)->clk = 1;
+        lanes.eval();
+        for (int i = 0; i < lanes.lanes(); ++i) randoms[i].push_back(lanes.modelp(i)->rnd);
+        if (lanes.contextp(0)->time() > 100) vl_fatal(__FILE__, __LINE__, "main", "Timeout");
+    }
+    for (int i = 0; i < lanes.lanes(); ++i) {
+        if (lanes.contextp(i)->time() != 4) {
+            vl_fatal(__FILE__, __LINE__, "main", "Lanes did not finish together");
+        }
+    }
+    if (Verilated::gotFinish()) vl_fatal(__FILE__, __LINE__, "main", "Global $finish set");
+
+    // Lanes differ only in their seed, so %m is the same in every lane
+    for (int i = 0; i < lanes.lanes(); ++i) {
+        std::string path = VL_CVT_PACK_STR_NW(4, lanes.modelp(i)->path);
+        if (path != "TOP.t") {
+            VL_PRINTF("%%Error: lane %d %%m is '%s'\n", i, path.c_str());
+            vl_fatal(__FILE__, __LINE__, "main", "Lane has a different %m");
+        }
+    }
+
+    lanes.final();
+
+    // Each lane has its own seed, so its own $urandom sequence
+    for (int i = 1; i < lanes.lanes(); ++i) {
+        if (randoms[i] == randoms[0]) {
+            vl_fatal(__FILE__, __LINE__, "main", "Lanes share a random sequence");
+        }
+    }
+    // Which is reproduced by a model alone with that lane's seed
+    VerilatedContext context;
+    context.commandArgs(2, argsa);
+    context.randSeed(1 + 2);
+    Vt_lanes* topp = new Vt_lanes(&context, "solo");
+    Randoms solo;
+    while (!context.gotFinish()) {
+        topp->clk = 0;
+        topp->eval();
+        context.timeInc(1);
+        topp->clk = 1;
+        topp->eval();
+        solo.push_back(topp->rnd);
+    }
+    topp->final();
+    delete topp;
+    if (solo != randoms[2]) {
+        vl_fatal(__FILE__, __LINE__, "main", "Lane not reproducible from its seed");
+    }
+
+    VL_PRINTF("*-* All Finished *-*\n");
+    return 0;
+}
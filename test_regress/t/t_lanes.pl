@@ -0,0 +1,29 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+scenarios(vlt_all => 1);
+
+compile(
+    make_top_shell => 0,
+    make_main => 0,
+    verilator_flags2 => ["--exe $Self->{t_dir}/$Self->{name}.cpp"],
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+# Every lane reports the same hierarchy, then the solo model its own
+my @laneLines = (file_contents($Self->{run_log_filename}) =~ /^\[4\] TOP\.t limit=4$/mg);
+(scalar(@laneLines) == 4) or error("Expected 4 lanes to print 'TOP.t', got "
+                                   .scalar(@laneLines)."\n");
+file_grep($Self->{run_log_filename}, qr!^\[4\] solo\.t limit=4$!m);
+
+ok(1);
+1;
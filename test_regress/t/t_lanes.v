@@ -0,0 +1,34 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2020 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Outputs
+   rnd, path,
+   // Inputs
+   clk
+   );
+   input clk;
+   output reg [31:0] rnd;
+   output reg [127:0] path;
+
+   integer cyc = 0;
+   integer limit;
+
+   initial begin
+      if (!$value$plusargs("limit=%d", limit)) $stop;
+      // Every lane has the model's name, not a per-lane one
+      $sformat(path, "%m");
+   end
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      // From the context's random seed
+      rnd <= $urandom;
+      if (cyc == limit - 1) begin
+         $write("[%0t] %m limit=%0d\n", $time, limit);
+         $finish;
+      end
+   end
+endmodule
@@ -0,0 +1,154 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2020 by Wilson Snyder.
+
+#include <verilated.h>
+#include "Vt_math_wide_quads.h"
+
+#include <cstdio>
+#include <cstring>
+
+double sc_time_stamp() { return 0; }
+
+// Random operand words, as the wide helpers only see raw words
+static vluint64_t s_seed = VL_ULL(0x5aef0c8dd70a4497);
+static EData randWord() {
+    s_seed = s_seed * VL_ULL(6364136223846793005) + VL_ULL(1442695040888963407);
+    EData data = static_cast<EData>(s_seed >> 32);
+    // Favor all-ones and all-zeros words to exercise the carry chains
+    switch (data & 7) {
+    case 0: return 0;
+    case 1: return ~static_cast<EData>(0);
+    default: return data;
+    }
+}
+
+// Word by word reference versions, as used without VL_WIDE_QUADS
+static void refAdd(int words, WDataOutP owp, WDataInP lwp, WDataInP rwp) {
+    QData carry = 0;
+    for (int i = 0; i < words; ++i) {
+        carry = carry + static_cast<QData>(lwp[i]) + static_cast<QData>(rwp[i]);
+        owp[i] = (carry & VL_ULL(0xffffffff));
+        carry = (carry >> VL_ULL(32)) & VL_ULL(0xffffffff);
+    }
+}
+static void refSub(int words, WDataOutP owp, WDataInP lwp, WDataInP rwp) {
+    QData carry = 0;
+    for (int i = 0; i < words; ++i) {
+        carry = (carry + static_cast<QData>(lwp[i])
+                 + static_cast<QData>(static_cast<IData>(~rwp[i])));
+        if (i == 0) ++carry;
+        owp[i] = (carry & VL_ULL(0xffffffff));
+        carry = (carry >> VL_ULL(32)) & VL_ULL(0xffffffff);
+    }
+}
+static void refMul(int words, WDataOutP owp, WDataInP lwp, WDataInP rwp) {
+    for (int i = 0; i < words; ++i) owp[i] = 0;
+    for (int lword = 0; lword < words; ++lword) {
+        for (int rword = 0; rword < words; ++rword) {
+            QData mul = static_cast<QData>(lwp[lword]) * static_cast<QData>(rwp[rword]);
+            for (int qword = lword + rword; qword < words; ++qword) {
+                mul += static_cast<QData>(owp[qword]);
+                owp[qword] = (mul & VL_ULL(0xffffffff));
+                mul = (mul >> VL_ULL(32)) & VL_ULL(0xffffffff);
+            }
+        }
+    }
+}
+static int refCmp(int words, WDataInP lwp, WDataInP rwp) {
+    for (int i = words - 1; i >= 0; --i) {
+        if (lwp[i] != rwp[i]) return (lwp[i] > rwp[i]) ? 1 : -1;
+    }
+    return 0;
+}
+
+static int s_errors = 0;
+
+static void check(const char* opname, int words, WDataInP gotp, WDataInP expp,
+                  WDataInP lwp, WDataInP rwp) {
+    if (0 == memcmp(gotp, expp, words * sizeof(EData))) return;
+    if (++s_errors > 10) return;
+    printf("%%Error: %s of %d words differs\n", opname, words);
+    for (int i = words - 1; i >= 0; --i) {
+        printf("  [%2d] l=%08x r=%08x got=%08x exp=%08x\n",
+               i, lwp[i], rwp[i], gotp[i], expp[i]);
+    }
+}
+
+static void checkCmp(int words, WDataInP lwp, WDataInP rwp) {
+    int exp = refCmp(words, lwp, rwp);
+    if ((VL_EQ_W(words, lwp, rwp) != 0) != (exp == 0)
+        || (VL_NEQ_W(words, lwp, rwp) != 0) != (exp != 0)
+        || (VL_LT_W(words, lwp, rwp) != 0) != (exp < 0)
+        || (VL_LTE_W(words, lwp, rwp) != 0) != (exp <= 0)
+        || (VL_GT_W(words, lwp, rwp) != 0) != (exp > 0)
+        || (VL_GTE_W(words, lwp, rwp) != 0) != (exp >= 0)) {
+        if (++s_errors > 10) return;
+        printf("%%Error: compare of %d words differs, expected %d\n", words, exp);
+    }
+}
+
+enum { MAX_WORDS = 20, ITERATIONS = 2000 };
+
+int main(int argc, char** argv, char** env) {
+    Verilated::commandArgs(argc, argv);
+
+#ifdef VL_WIDE_QUADS
+    printf("Wide helpers use quads\n");
+#endif
+    for (int words = 1; words <= MAX_WORDS; ++words) {
+        for (int iter = 0; iter < ITERATIONS; ++iter) {
+            // One past the end, to catch a quad access past the last odd word
+            EData lhs[MAX_WORDS + 1];
+            EData rhs[MAX_WORDS + 1];
+            EData got[MAX_WORDS + 1];
+            EData exp[MAX_WORDS + 1];
+            for (int i = 0; i <= words; ++i) {
+                lhs[i] = randWord();
+                rhs[i] = randWord();
+            }
+            // Sometimes equal, or equal but for one word, to reach each compare outcome
+            if (iter % 4 == 1) memcpy(rhs, lhs, words * sizeof(EData));
+            if (iter % 4 == 2) {
+                memcpy(rhs, lhs, words * sizeof(EData));
+                rhs[iter % words] ^= 1;
+            }
+            const EData guard = got[words] = exp[words] = 0xdeadbeef;
+
+            refAdd(words, exp, lhs, rhs);
+            VL_ADD_W(words, got, lhs, rhs);
+            check("add", words, got, exp, lhs, rhs);
+            memcpy(got, lhs, words * sizeof(EData));
+            VL_ADD_W(words, got, got, rhs);  // Output aliases input
+            check("add in place", words, got, exp, lhs, rhs);
+
+            refSub(words, exp, lhs, rhs);
+            VL_SUB_W(words, got, lhs, rhs);
+            check("sub", words, got, exp, lhs, rhs);
+            memcpy(got, lhs, words * sizeof(EData));
+            VL_SUB_W(words, got, got, rhs);
+            check("sub in place", words, got, exp, lhs, rhs);
+
+            refMul(words, exp, lhs, rhs);
+            VL_MUL_W(words, got, lhs, rhs);
+            check("mul", words, got, exp, lhs, rhs);
+
+            checkCmp(words, lhs, rhs);
+
+            if (got[words] != guard) {
+                printf("%%Error: wrote past %d words\n", words);
+                ++s_errors;
+            }
+        }
+    }
+    if (s_errors) vl_fatal(__FILE__, __LINE__, "main", "Wide math mismatches");
+
+    Vt_math_wide_quads* topp = new Vt_math_wide_quads;
+    while (!Verilated::gotFinish()) topp->eval();
+    topp->final();
+    delete topp; VL_DANGLING(topp);
+    return 0;
+}
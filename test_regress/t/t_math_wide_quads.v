@@ -0,0 +1,12 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2020 by Wilson Snyder.
+
+module t (/*AUTOARG*/);
+   // The checks are in t_math_wide_quads.cpp; this only ends the run
+   initial begin
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
@@ -0,0 +1,28 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+scenarios(simulator => 1);
+
+compile(
+    verilator_flags2 => ["--stats"],
+    );
+
+if ($Self->{vlt}) {
+    # Each g[i].en; g[i].ok is inlined into oks by V3Gate.
+    # Of the clocked bits only d0..d5 may be packed.
+    file_grep($Self->{stats}, qr/Optimizations, Bits packed into words\s+(\d+)/i, 22);
+    file_grep($Self->{stats}, qr/Optimizations, Packed bit words\s+(\d+)/i, 2);
+}
+
+execute(
+    check_finished => 1,
+    );
+
+ok(1);
+1;
@@ -0,0 +1,103 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2020 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+   integer cyc; initial cyc=1;
+
+   reg [63:0] crc;
+   reg [63:0] sum;
+
+   wire [15:0] ens;
+   wire [15:0] oks;
+
+   // Replicated single bit glue logic, each bit used more than once
+   genvar i;
+   generate
+      for (i = 0; i < 16; i = i + 1) begin : g
+         wire en = (crc[i] & crc[i+16]) | crc[63];
+         wire ok = ~(en ^ crc[i+32]);
+         assign ens[i] = en;
+         assign oks[i] = ok & en;
+      end
+   endgenerate
+
+   wire [15:0] exp_en = (crc[15:0] & crc[31:16]) | {16{crc[63]}};
+   wire [15:0] exp_ok = ~(exp_en ^ crc[47:32]) & exp_en;
+
+   // Not packed: a3 is read between a2 and a3, so a3..a5 can't be
+   // hoisted above the read, leaving two runs too short to pack
+   reg a0, a1, a2, a3, a4, a5;
+   reg [5:0] as;
+   reg ra, ra_exp;
+   // Not packed: $write between b2 and b3 is a barrier
+   reg b0, b1, b2, b3, b4, b5;
+   // Not packed: only written in slow code
+   reg c0, c1, c2, c3, c4, c5;
+   // Packed: the initial writes become selects of the packed word
+   reg d0, d1, d2, d3, d4, d5;
+   reg [5:0] dsave;
+
+   initial begin
+      c0 = 1'b1; c1 = 1'b0; c2 = 1'b1; c3 = 1'b0; c4 = 1'b1; c5 = 1'b0;
+      d0 = 1'b1; d1 = 1'b1; d2 = 1'b1; d3 = 1'b1; d4 = 1'b1; d5 = 1'b1;
+   end
+
+   always @ (posedge clk) begin
+      a0 = crc[0] & crc[8];
+      a1 = crc[1] & crc[9];
+      a2 = crc[2] & crc[10];
+      ra <= a3;
+      ra_exp <= as[3];
+      a3 = crc[3] & crc[11];
+      a4 = crc[4] & crc[12];
+      a5 = crc[5] & crc[13];
+      as <= {a5, a4, a3, a2, a1, a0};
+      if ({a5, a4, a3, a2, a1, a0} !== (crc[5:0] & crc[13:8])) $stop;
+      if (cyc > 3 && ra !== ra_exp) $stop;
+
+      b0 = crc[0] | crc[8];
+      b1 = crc[1] | crc[9];
+      b2 = crc[2] | crc[10];
+      if (cyc == 1000) $write("never\n");
+      b3 = crc[3] | crc[11];
+      b4 = crc[4] | crc[12];
+      b5 = crc[5] | crc[13];
+      if ({b5, b4, b3, b2, b1, b0} !== (crc[5:0] | crc[13:8])) $stop;
+
+      if ({c5, c4, c3, c2, c1, c0} !== 6'b010101) $stop;
+
+      dsave <= {d5, d4, d3, d2, d1, d0};
+      d0 = crc[0] ^ crc[8];
+      d1 = crc[1] ^ crc[9];
+      d2 = crc[2] ^ crc[10];
+      d3 = crc[3] ^ crc[11];
+      d4 = crc[4] ^ crc[12];
+      d5 = crc[5] ^ crc[13];
+      if ({d5, d4, d3, d2, d1, d0} !== (crc[5:0] ^ crc[13:8])) $stop;
+      if (cyc == 2 && dsave !== 6'h3f) $stop;
+   end
+
+   always @ (posedge clk) begin
+      if (ens !== exp_en) $stop;
+      if (oks !== exp_ok) $stop;
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63]^crc[2]^crc[0]};
+      sum <= {sum[62:0], sum[63]^sum[2]^sum[0]} ^ {32'h0, oks, ens};
+      if (cyc==1) begin
+         crc <= 64'h5aef0c8d_d70a4497;
+         sum <= 64'h0;
+      end
+      else if (cyc==99) begin
+         $write("[%0t] cyc==%0d crc=%x sum=%x\n", $time, cyc, crc, sum);
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
@@ -0,0 +1,28 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+scenarios(vltmt => 1);
+
+top_filename("t/t_opt_packbits.v");
+
+compile(
+    verilator_flags2 => ["--threads 2 --stats"],
+    );
+
+# Which glue bits share an mtask depends on the partitioning, but the
+# clocked d0..d5 are in one always block, so are always packed
+file_grep($Self->{stats}, qr/Optimizations, Bits packed into words\s+([1-9]\d*)/i);
+file_grep($Self->{stats}, qr/Optimizations, Packed bit words\s+([1-9]\d*)/i);
+
+execute(
+    check_finished => 1,
+    );
+
+ok(1);
+1;
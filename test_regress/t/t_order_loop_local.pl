@@ -0,0 +1,39 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+scenarios(simulator => 1);
+
+compile(
+    v_flags2 => ["t/t_order_loop_local_c.cpp"],
+    verilator_flags2 => ["--stats -Wno-UNOPTFLAT",
+                         # Local loops are only formed for serial scheduling
+                         ($Self->{vlt} ? "+define+TEST_ONCE_PER_STEP" : "")],
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+if ($Self->{vlt}) {
+    # The x bus, and the a/b pair
+    file_grep($Self->{stats}, qr/Order, local loops\s+(\d+)/i, 2);
+    # Converged in place, so nothing watches the loops' variables
+    my $text = file_contents("$Self->{obj_dir}/$Self->{VM_PREFIX}.cpp");
+    my @changeFuncs = ($text =~ /\n[^\n]*\b$Self->{VM_PREFIX}::_change_request\w*\(.*?\n}\n/sg);
+    @changeFuncs or error("No _change_request functions found");
+    foreach my $func (@changeFuncs) {
+        if ($func =~ /\bt__DOT__(x|a|b)\b/) {
+            error("_change_request still watches '$1'");
+        }
+    }
+    file_grep_not("$Self->{obj_dir}/$Self->{VM_PREFIX}.h", qr/__Vchglast__\w*t__DOT__(x|a|b)\b/);
+}
+
+ok(1);
+1;
@@ -0,0 +1,77 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2020 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer      cyc = 0;
+   logic        in;
+   logic [3:0]  sum;
+
+   // Circular only per-bus; needs several passes to settle, which should
+   // happen around just this logic
+   wire [3:0]   x = {x[2:0], in};
+
+   // Two blocks feeding each other
+   logic [7:0]  a;
+   logic [7:0]  b;
+   always_comb a = {b[6:0], in};
+   always_comb b = {a[6:0], 1'b0};
+
+   // Reads the loops' results, so must follow them
+   assign sum = x + a[3:0];
+
+   import "DPI-C" function void dpii_eval_tick();
+   import "DPI-C" function int dpii_eval_ticks();
+
+   // Outside the loops, so runs once each time the whole model is
+   // evaluated, counting the passes each step takes
+   logic        probe;
+   always_comb begin
+      probe = in;
+      dpii_eval_tick();
+   end
+
+   integer      ticks;
+   integer      last_ticks = 0;
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      in <= cyc[0];
+      if (cyc > 1) begin
+         // 'in' was just set from the previous cycle's parity
+         if (x !== {4{~cyc[0]}}) begin
+            $write("%%Error: cyc=%0d x=%x\n", cyc, x);
+            $stop;
+         end
+         if (a !== (8'h55 & {8{~cyc[0]}})) begin
+            $write("%%Error: cyc=%0d a=%x b=%x\n", cyc, a, b);
+            $stop;
+         end
+         if (sum !== x + a[3:0]) begin
+            $write("%%Error: cyc=%0d sum=%x\n", cyc, sum);
+            $stop;
+         end
+      end
+      ticks = dpii_eval_ticks();
+`ifdef TEST_ONCE_PER_STEP
+      // With the loops converged in place, the posedge and the negedge
+      // each evaluate the rest of the design exactly once
+      if (cyc > 3 && ticks - last_ticks != 2) begin
+         $write("%%Error: cyc=%0d evaluated %0d times since last posedge\n",
+                cyc, ticks - last_ticks);
+         $stop;
+      end
+`endif
+      last_ticks <= ticks;
+      if (cyc == 10) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
@@ -0,0 +1,55 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+scenarios(vlt => 1);
+
+my $secret_prefix = "secret";
+my $secret_dir = "$Self->{obj_dir}/$secret_prefix";
+mkdir $secret_dir;
+
+while (1) {
+    run(logfile => "$secret_dir/vlt_compile.log",
+        cmd => ["perl",
+                "$ENV{VERILATOR_ROOT}/bin/verilator",
+                "--prefix",
+                "Vt_prot_lib_mask_secret",
+                "-cc",
+                "-Mdir",
+                $secret_dir,
+                "--protect-lib",
+                $secret_prefix,
+                "t/t_prot_lib_mask_secret.v"]);
+    last if $Self->{errors};
+
+    run(logfile => "$secret_dir/secret_gcc.log",
+        cmd=>["make",
+              "-C",
+              $secret_dir,
+              "-f",
+              "Vt_prot_lib_mask_secret.mk"]);
+    last if $Self->{errors};
+
+    # Narrow and quad 2-state inputs are masked to the port width
+    file_grep("$secret_dir/secret.cpp", qr/handlep__V->s5_in = \*s5_in & VL_MASK_I\(5\);/);
+    file_grep("$secret_dir/secret.cpp",
+              qr/handlep__V->s37_in = VL_SET_QW\(s37_in\) & VL_MASK_Q\(37\);/);
+
+    compile(
+        verilator_flags2 => ["-LDFLAGS",
+                             "'-L$secret_prefix -lsecret -static'"],
+        );
+
+    execute(
+        check_finished => 1,
+        );
+
+    ok(1);
+    last;
+}
+1;
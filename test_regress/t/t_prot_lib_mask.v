@@ -0,0 +1,55 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// Call the --protect-lib library directly, with the bits above each port's
+// width set, as another simulator's DPI layer may do.
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2020 by Wilson Snyder.
+
+module t (/*AUTOARG*/);
+
+   import "DPI-C" function chandle secret_protectlib_create (string scope__V);
+   // Ports are wider than the library's, so the upper bits can be dirtied
+   import "DPI-C" function longint secret_protectlib_combo_update
+     (chandle handle__V,
+      bit [31:0] s5_in, output bit [31:0] s5_out, output bit s5_eq,
+      bit [63:0] s37_in, output bit [63:0] s37_out, output bit s37_eq);
+   import "DPI-C" function void secret_protectlib_final (chandle handle__V);
+
+   chandle handle;
+   bit [31:0] s5_out;
+   bit        s5_eq;
+   bit [63:0] s37_out;
+   bit        s37_eq;
+   longint    seqnum;
+
+   initial begin
+      handle = secret_protectlib_create("top.t.secret");
+
+      seqnum = secret_protectlib_combo_update(handle,
+                                              32'hffff_ffe0 | 32'h15, s5_out, s5_eq,
+                                              64'hffff_ffe0_0000_0000 | 64'h15_1234_5678,
+                                              s37_out, s37_eq);
+`ifdef TEST_VERBOSE
+      $write("s5_out=%x s5_eq=%x s37_out=%x s37_eq=%x\n", s5_out, s5_eq, s37_out, s37_eq);
+`endif
+      if (s5_out !== 32'h15) $stop;
+      if (s5_eq !== 1'b1) $stop;
+      if (s37_out !== 64'h15_1234_5678) $stop;
+      if (s37_eq !== 1'b1) $stop;
+
+      seqnum = secret_protectlib_combo_update(handle,
+                                              32'hffff_ffe0 | 32'h0a, s5_out, s5_eq,
+                                              64'hffff_ffe0_0000_0000 | 64'h0a_8765_4321,
+                                              s37_out, s37_eq);
+      if (s5_out !== 32'h0a) $stop;
+      if (s5_eq !== 1'b0) $stop;
+      if (s37_out !== 64'h0a_8765_4321) $stop;
+      if (s37_eq !== 1'b0) $stop;
+
+      secret_protectlib_final(handle);
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+
+endmodule
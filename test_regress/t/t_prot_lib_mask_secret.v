@@ -0,0 +1,22 @@
+// DESCRIPTION: Verilator: Verilog Test module
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2020 by Wilson Snyder.
+
+module secret (
+               input [4:0]         s5_in,
+               output logic [4:0]  s5_out,
+               output logic        s5_eq,
+               input [36:0]        s37_in,
+               output logic [36:0] s37_out,
+               output logic        s37_eq);
+
+   // Odd widths, so any bits above the port width the caller leaves set
+   // would show up in the outputs and break the compares
+   always @(*) begin
+      s5_out = s5_in;
+      s5_eq = (s5_in == 5'h15);
+      s37_out = s37_in;
+      s37_eq = (s37_in == 37'h15_1234_5678);
+   end
+
+endmodule
@@ -0,0 +1,45 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+scenarios(simulator => 1);
+
+compile(
+    verilator_flags2 => ["--stats --quiesce-min-cost 1"],
+    );
+
+if ($Self->{vlt}) {
+    # The top's mix logic, and the hash instance's logic
+    file_grep($Self->{stats}, qr/Optimizations, Quiesce regions guarded\s+(\d+)/i, 2);
+    # One region is guarded only by hold, which is idle 7 of every 8 cycles
+    my %inputs;
+    foreach my $file (glob("$Self->{obj_dir}/$Self->{VM_PREFIX}*.h")) {
+        foreach my $line (split /\n/, file_contents($file)) {
+            $inputs{$1}{$2} = 1 if $line =~ /\b__Vqs(\d+)__(TOP__\w+);/;
+        }
+    }
+    my $holdOnly = 0;
+    foreach my $region (sort keys %inputs) {
+        my @names = sort keys %{$inputs{$region}};
+        print "Region $region inputs: @names\n" if $Self->{verbose};
+        $holdOnly = 1 if !grep { !/(hold|hsh__in)$/ } @names;
+    }
+    $holdOnly or error("No quiesce region guarded by hold alone\n");
+}
+elsif ($Self->{vltmt}) {
+    # Each mtask's combo logic is one function; how the two regions share
+    # mtasks depends on the partitioner
+    file_grep($Self->{stats}, qr/Optimizations, Quiesce regions guarded\s+([1-9]\d*)/i);
+}
+
+execute(
+    check_finished => 1,
+    );
+
+ok(1);
+1;
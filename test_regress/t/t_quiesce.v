@@ -0,0 +1,96 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2020 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+   integer cyc; initial cyc=1;
+
+   reg [63:0] crc;
+   reg [63:0] hold;  // Changes only every 8 cycles
+   reg [63:0] last_hold;
+   reg [63:0] last_hmix;
+
+   // Combo logic (reads clk as data, so it isn't inlined into the always
+   // block); its inputs change every evaluation, so it is never skipped
+   wire [63:0] mix = (clk ? (crc * 64'h9e3779b97f4a7c15) : (crc + 64'h5bd1e995))
+                     ^ ((hold * 64'h27d4eb2f165667c5) ^ (hold >> 13))
+                     ^ (((crc ^ hold) * 64'hc2b2ae3d27d4eb4f) >> 7)
+                     ^ ((crc + hold) * 64'h165667b19e3779f9)
+                     ^ ((crc - hold) * 64'h85ebca77c2b2ae63)
+                     ^ ((hold ^ 64'hff51afd7ed558ccd) * crc);
+
+   // Separate instance, so its combo logic is its own region; it reads
+   // only hold, so it is skipped for the 7 of 8 cycles hold is unchanged
+   wire [63:0] hmix;
+   hash hsh (.in(hold), .out(hmix));
+
+   always @ (posedge clk) begin
+      if (mix !== ((crc * 64'h9e3779b97f4a7c15)
+                   ^ ((hold * 64'h27d4eb2f165667c5) ^ (hold >> 13))
+                   ^ (((crc ^ hold) * 64'hc2b2ae3d27d4eb4f) >> 7)
+                   ^ ((crc + hold) * 64'h165667b19e3779f9)
+                   ^ ((crc - hold) * 64'h85ebca77c2b2ae63)
+                   ^ ((hold ^ 64'hff51afd7ed558ccd) * crc))) $stop;
+      // Correct while skipped, and recomputed when hold changes
+      if (hmix !== hash_f(hold)) $stop;
+      if (cyc > 2) begin
+         if ((hold == last_hold) != (hmix == last_hmix)) $stop;
+      end
+      last_hold <= hold;
+      last_hmix <= hmix;
+`ifdef TEST_VERBOSE
+      $write("[%0t] cyc=%0d hold=%x hmix=%x\n", $time, cyc, hold, hmix);
+`endif
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63]^crc[2]^crc[0]};
+      if (cyc[2:0] == 3'd0) hold <= crc;
+      if (cyc==1) begin
+         crc <= 64'h5aef0c8d_d70a4497;
+         hold <= 64'h0;
+      end
+      else if (cyc==99) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+   // Each step is invertible, so different inputs give different outputs
+   function [63:0] hash_f(input [63:0] in);
+      reg [63:0] h;
+      h = in * 64'h9e3779b97f4a7c15;
+      h = (h ^ (h >> 29)) * 64'hbf58476d1ce4e5b9;
+      h = (h ^ (h >> 32)) * 64'h94d049bb133111eb;
+      h = (h ^ (h >> 31)) * 64'hc2b2ae3d27d4eb4f;
+      h = (h ^ (h >> 27)) * 64'h165667b19e3779f9;
+      hash_f = h ^ (h >> 33);
+   endfunction
+endmodule
+
+module hash (/*AUTOARG*/
+   // Outputs
+   out,
+   // Inputs
+   in
+   );
+   /*verilator no_inline_module*/
+   input [63:0] in;
+   output reg [63:0] out;
+
+   reg [63:0] h1, h2, h3, h4, h5;
+
+   // Several statements, so V3Gate keeps it as a block
+   always @(*) begin
+      h1 = in * 64'h9e3779b97f4a7c15;
+      h2 = (h1 ^ (h1 >> 29)) * 64'hbf58476d1ce4e5b9;
+      h3 = (h2 ^ (h2 >> 32)) * 64'h94d049bb133111eb;
+      h4 = (h3 ^ (h3 >> 31)) * 64'hc2b2ae3d27d4eb4f;
+      h5 = (h4 ^ (h4 >> 27)) * 64'h165667b19e3779f9;
+      out = h5 ^ (h5 >> 33);
+   end
+endmodule
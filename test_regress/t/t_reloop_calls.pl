@@ -0,0 +1,28 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+scenarios(simulator => 1);
+
+compile(
+    verilator_flags2 => ["--stats"],
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+if ($Self->{vlt}) {
+    # How many call runs are re-rolled depends on how sub's logic is split.
+    # Not checked under --threads, where calls from mtask bodies are kept.
+    file_grep($Self->{stats}, qr/Optimizations, Reloop instance calls\s+([1-9]\d*)/i);
+    file_grep("$Self->{obj_dir}/$Self->{VM_PREFIX}__Syms.h", qr/__Vinst__sub\[16\];/);
+}
+
+ok(1);
+1;
@@ -0,0 +1,53 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2020 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer      cyc = 0;
+   logic [31:0] in = 32'h1;
+   logic [31:0] in_d1 = 32'h0;
+   logic [31:0] in_d2 = 32'h0;
+   logic [31:0] outs [0:15];
+
+   genvar       g;
+   generate
+      for (g = 0; g < 16; g = g + 1) begin : gen
+         sub sub (.clk, .in(in + g), .out(outs[g]));
+      end
+   endgenerate
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      in <= in * 32'd3 + 32'd1;
+      in_d1 <= in;
+      in_d2 <= in_d1;
+      if (cyc > 2) begin
+         for (int i = 0; i < 16; i = i + 1) begin
+            // Each sub delays its input by two cycles
+            if (outs[i] !== (in_d2 + i) * 32'd5) begin
+               $write("%%Error: cyc=%0d outs[%0d]=%x\n", cyc, i, outs[i]);
+               $stop;
+            end
+         end
+      end
+      if (cyc == 20) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
+
+module sub (input clk, input [31:0] in, output logic [31:0] out);
+   /*verilator no_inline_module*/
+   logic [31:0] q;
+   always @(posedge clk) begin
+      q <= in;
+      out <= q * 32'd5;
+   end
+endmodule
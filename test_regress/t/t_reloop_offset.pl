@@ -0,0 +1,31 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+scenarios(simulator => 1);
+
+compile(
+    verilator_flags2 => ["-unroll-count 256", "--stats"],
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+# The gen[] assigns, in both the clocked and settle functions
+if ($Self->{vlt}) {
+    file_grep($Self->{stats}, qr/Optimizations, Reloop iterations\s+(\d+)/i, 128);
+    file_grep($Self->{stats}, qr/Optimizations, Reloops\s+(\d+)/i, 2);
+}
+elsif ($Self->{vltmt}) {
+    # Partitioning may split the assigns between mtasks
+    file_grep($Self->{stats}, qr/Optimizations, Reloops\s+([1-9]\d*)/i);
+}
+
+ok(1);
+1;
@@ -0,0 +1,44 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2020 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer      cyc = 0;
+
+   logic [7:0]  src [0:65];
+   logic [7:0]  mask [0:3];
+   logic [7:0]  dst [0:63];
+
+   // Each instance reads a shifted source and the same mask element
+   genvar       g;
+   generate
+      for (g = 0; g < 64; g = g + 1) begin : gen
+         assign dst[g] = src[g + 2] ^ mask[1];
+      end
+   endgenerate
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      for (int i = 0; i < 66; i = i + 1) src[i] <= cyc[7:0] * 8'd7 + i[7:0];
+      for (int i = 0; i < 4; i = i + 1) mask[i] <= cyc[7:0] * 8'd3 - i[7:0];
+      if (cyc > 0) begin
+         for (int i = 0; i < 64; i = i + 1) begin
+            if (dst[i] !== (((cyc[7:0] - 8'd1) * 8'd7 + i[7:0] + 8'd2)
+                            ^ ((cyc[7:0] - 8'd1) * 8'd3 - 8'd1))) begin
+               $write("%%Error: cyc=%0d dst[%0d]=%x\n", cyc, i, dst[i]);
+               $stop;
+            end
+         end
+      end
+      if (cyc == 99) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
@@ -0,0 +1,50 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2020 by Wilson Snyder.
+
+`define STRINGIFY(x) `"x`"
+
+module t;
+
+   // Enough to overflow the $fopen write buffer several times
+   localparam LINES = 20000;
+
+   integer      fd;
+   integer      fdr;
+   integer      i;
+   integer      chars;
+   reg [16*8:1] line;
+   reg [16*8:1] exp;
+
+   initial begin
+      fd = $fopen({`STRINGIFY(`TEST_OBJ_DIR),"/t_sys_file_buffer.log"}, "w");
+      if (fd == 0) $stop;
+      for (i = 0; i < LINES; i = i + 1) $fwrite(fd, "line %0d\n", i);
+
+      // All buffered output must be visible after $fflush
+      $fflush(fd);
+      fdr = $fopen({`STRINGIFY(`TEST_OBJ_DIR),"/t_sys_file_buffer.log"}, "r");
+      if (fdr == 0) $stop;
+      for (i = 0; i < LINES; i = i + 1) begin
+         line = 0;
+         chars = $fgets(line, fdr);
+         $sformat(exp, "line %0d\n", i);
+         if (chars == 0 || line !== exp) begin
+            $write("%%Error: line %0d: got '%0s' exp '%0s'\n", i, line, exp);
+            $stop;
+         end
+      end
+      chars = $fgets(line, fdr);
+      if (chars != 0) $stop;
+      $fclose(fdr);
+
+      // And the rest once closed
+      $fwrite(fd, "end\n");
+      $fclose(fd);
+
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+
+endmodule
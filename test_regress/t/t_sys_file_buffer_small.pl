@@ -0,0 +1,29 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+scenarios(vlt_all => 1);
+
+top_filename("t/t_sys_file_buffer.v");
+
+unlink("$Self->{obj_dir}/t_sys_file_buffer.log");
+
+compile(
+    # Buffer smaller than a line, so most writes flush
+    verilator_flags2 => ["-CFLAGS -DVL_FOPEN_BUFFER_SIZE=8"],
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+file_grep("$Self->{obj_dir}/t_sys_file_buffer.log", qr/\Aline 0\nline 1\n/);
+file_grep("$Self->{obj_dir}/t_sys_file_buffer.log", qr/\nline 19999\nend\n\z/);
+
+ok(1);
+1;
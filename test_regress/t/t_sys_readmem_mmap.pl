@@ -0,0 +1,39 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+use IO::File;
+use strict;
+use vars qw($Self);
+
+scenarios(simulator => 1);
+
+sub gen {
+    my $filename = shift;
+
+    # Exactly one page, with the last number ending at the last byte and no
+    # newline, so a mapped parse that read past the end would be caught
+    my $fh = IO::File->new(">$filename");
+    for (my $i=0; $i<511; ++$i) {
+        $fh->printf("%07x\n", $i * 3);
+    }
+    $fh->printf("%08x", 511 * 3);
+}
+
+gen("$Self->{obj_dir}/t_sys_readmem_mmap.mem");
+# An empty file can't be mapped
+write_wholefile("$Self->{obj_dir}/t_sys_readmem_mmap_empty.mem", "");
+
+compile(
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+ok(1);
+1;
@@ -0,0 +1,33 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2020 by Wilson Snyder.
+
+`define STRINGIFY(x) `"x`"
+
+module t;
+
+   reg [31:0] mem [0:511];
+   reg [31:0] empty [0:3];
+
+   integer    i;
+
+   initial begin
+      $readmemh({`STRINGIFY(`TEST_OBJ_DIR),"/t_sys_readmem_mmap.mem"}, mem);
+      for (i = 0; i < 512; i = i + 1) begin
+         if (mem[i] !== i * 3) begin
+            $write("%%Error: mem[%0d]=%x\n", i, mem[i]);
+            $stop;
+         end
+      end
+
+      for (i = 0; i < 4; i = i + 1) empty[i] = 32'hdead;
+      $readmemh({`STRINGIFY(`TEST_OBJ_DIR),"/t_sys_readmem_mmap_empty.mem"}, empty);
+      for (i = 0; i < 4; i = i + 1) begin
+         if (empty[i] !== 32'hdead) $stop;
+      end
+
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
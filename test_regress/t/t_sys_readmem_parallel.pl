@@ -0,0 +1,36 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+use IO::File;
+use strict;
+use vars qw($Self);
+
+# Threaded runtime loads dense files of at least 4MB per thread in parallel,
+# when the host has the cores for it
+scenarios(vltmt => 1);
+
+sub gen {
+    my $filename = shift;
+
+    my $fh = IO::File->new(">$filename");
+    for (my $i=0; $i<(1<<20); ++$i) {
+        $fh->printf("%08x\n", ($i * 0x9e3779b1) & 0xffffffff);
+    }
+}
+
+gen("$Self->{obj_dir}/t_sys_readmem_parallel.mem");
+
+compile(
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+ok(1);
+1;
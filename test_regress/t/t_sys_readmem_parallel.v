@@ -0,0 +1,30 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2020 by Wilson Snyder.
+
+`define STRINGIFY(x) `"x`"
+
+module t;
+
+   // 9MB of hex, 1M rows
+   reg [31:0] mem [0:1048575];
+
+   integer    i;
+
+   initial begin
+`ifdef BAD_END
+      $readmemh({`STRINGIFY(`TEST_OBJ_DIR),"/t_sys_readmem_parallel.mem"}, mem, 0, 1048579);
+`else
+      $readmemh({`STRINGIFY(`TEST_OBJ_DIR),"/t_sys_readmem_parallel.mem"}, mem);
+`endif
+      for (i = 0; i < 1048576; i = i + 1) begin
+         if (mem[i] !== i * 32'h9e3779b1) begin
+            $write("%%Error: mem[%0d]=%x\n", i, mem[i]);
+            $stop;
+         end
+      end
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
@@ -0,0 +1,26 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+scenarios(simulator => 1);
+
+compile(
+    );
+
+execute(
+    check_finished => 1,
+    expect => quotemeta("[   42|00042|%|1.23e+03]"),
+    );
+
+if ($Self->{vlt_all}) {
+    # Statements use the pre-parsed format table, not the format string
+    file_grep("$Self->{obj_dir}/$Self->{VM_PREFIX}__Slow.cpp", qr/VerilatedFormatOp __Vfmt/);
+}
+
+ok(1);
+1;
@@ -0,0 +1,61 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2020 by Wilson Snyder.
+
+module t;
+
+   // $display/$sformat statements are emitted as pre-parsed format tables
+
+   reg [7:0]    c;
+   reg [15:0]   s16;
+   reg [31:0]   i32;
+   reg [63:0]   q64;
+   reg [20*8:1] w;
+   string       str;
+   reg [7:0]    n;
+   reg signed [7:0] sn;
+   real         r;
+
+   initial begin
+      n = 8'd42;
+      sn = -8'sd5;
+      r = 1234.56;
+
+      // Widths and zero padding
+      $sformat(str, "[%5d|%05d|%0d|%5d]", n, n, n, sn);
+`ifdef TEST_VERBOSE  $display("str=%0s", str);  `endif
+      if (str != "[   42|00042|42|   -5]") $stop;
+
+      // Real precision
+      $sformat(str, "%.2e|%10.3f|%g", r, r, r);
+`ifdef TEST_VERBOSE  $display("str=%0s", str);  `endif
+      if (str != "1.23e+03|  1234.560|1234.56") $stop;
+
+      // Percents, including at start and end
+      $sformat(str, "%%100|%%d|%0d%%", n);
+`ifdef TEST_VERBOSE  $display("str=%0s", str);  `endif
+      if (str != "%100|%d|42%") $stop;
+
+      // Escapes, with no conversions
+      $sformat(w, "a\tb\\c\"d\n");
+      if (w !== {"a", 8'h09, "b", 8'h5c, "c", 8'h22, "d", 8'h0a}) $stop;
+
+      // Each size of destination
+      $sformat(c, "%0d", 8'd7);
+      if (c !== "7") $stop;
+      $sformat(s16, "%02d", 8'd5);
+      if (s16 !== "05") $stop;
+      $sformat(i32, "%%%0x", 8'hab);
+      if (i32 !== "%ab") $stop;
+      $sformat(q64, "%3d|%s", 8'd1, "xy");
+      if (q64 !== "  1|xy") $stop;
+      $sformat(w, "%b.%o", 4'b1010, 6'o17);
+      if (w !== "1010.17") $stop;
+
+      $write("[%5d|%05d|%%|%.2e]\n", n, n, r);
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+
+endmodule
@@ -0,0 +1,29 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+scenarios(simulator => 1);
+
+compile(
+    verilator_flags2 => ["--stats"],
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+if ($Self->{vlt_all}) {
+    # The 12-bit decoder is the only table, and its 4096 inputs map to
+    # few distinct {region, attr} rows, so it is stored as row numbers
+    file_grep($Self->{stats}, qr/Optimizations, Tables created\s+(\d+)/i, 1);
+    file_grep($Self->{stats}, qr/Optimizations, Tables of distinct rows\s+(\d+)/i, 1);
+    file_grep("$Self->{obj_dir}/$Self->{VM_PREFIX}.h", qr/__Vtablerow1\b/);
+}
+
+ok(1);
+1;
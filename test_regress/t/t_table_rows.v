@@ -0,0 +1,81 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2020 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer      cyc = 0;
+   logic [11:0] addr;
+   logic [31:0] attr;
+   logic [3:0]  region;
+
+   // Address decoder; many addresses, few distinct results,
+   // so the table is stored as row numbers into distinct rows
+   always_comb begin
+      casez (addr)
+        12'b0000_0000_????: begin region = 4'd1; attr = 32'h0000_0001; end
+        12'b0000_0001_????: begin region = 4'd2; attr = 32'h0000_0003; end
+        12'b0000_001?_????: begin region = 4'd3; attr = 32'h0000_0007; end
+        12'b0000_01??_????: begin region = 4'd4; attr = 32'h0000_000f; end
+        12'b0000_1???_????: begin region = 4'd5; attr = 32'h0000_001f; end
+        12'b0001_????_????: begin region = 4'd6; attr = 32'h0000_003f; end
+        12'b0010_????_????: begin region = 4'd7; attr = 32'h1000_0000; end
+        12'b0011_0???_????: begin region = 4'd7; attr = 32'h3000_0000; end
+        12'b0011_1???_????: begin region = 4'd8; attr = 32'h7000_0000; end
+        12'b01??_????_????: begin region = 4'd9; attr = 32'hf000_0000; end
+        12'b1000_????_???0: begin region = 4'd10; attr = 32'h00ff_0000; end
+        12'b1000_????_???1: begin region = 4'd10; attr = 32'h0f0f_0000; end
+        12'b1001_????_????: begin region = 4'd11; attr = 32'h8000_0001; end
+        12'b101?_????_????: begin region = 4'd12; attr = 32'h4000_0002; end
+        12'b1100_0000_0000: begin region = 4'd13; attr = 32'hdead_beef; end
+        12'b1100_????_????: begin region = 4'd13; attr = 32'h2000_0004; end
+        12'b1101_????_????: begin region = 4'd14; attr = 32'h1000_0008; end
+        12'b1111_1111_1111: begin region = 4'd15; attr = 32'hffff_ffff; end
+        default:            begin region = 4'd0;  attr = 32'h0000_0000; end
+      endcase
+   end
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      case (cyc)
+        0: addr <= 12'h000;
+        1: addr <= 12'h012;
+        2: addr <= 12'h035;
+        3: addr <= 12'h2ab;
+        4: addr <= 12'h381;
+        5: addr <= 12'h802;
+        6: addr <= 12'h803;
+        7: addr <= 12'hc00;
+        8: addr <= 12'hc01;
+        9: addr <= 12'hfff;
+        10: addr <= 12'he00;
+        default: addr <= 12'h5a5;
+      endcase
+      if (cyc > 0) begin
+         if ({region, attr} !== (cyc == 1 ? {4'd1, 32'h0000_0001}
+                                 : cyc == 2 ? {4'd2, 32'h0000_0003}
+                                 : cyc == 3 ? {4'd3, 32'h0000_0007}
+                                 : cyc == 4 ? {4'd7, 32'h1000_0000}
+                                 : cyc == 5 ? {4'd8, 32'h7000_0000}
+                                 : cyc == 6 ? {4'd10, 32'h00ff_0000}
+                                 : cyc == 7 ? {4'd10, 32'h0f0f_0000}
+                                 : cyc == 8 ? {4'd13, 32'hdead_beef}
+                                 : cyc == 9 ? {4'd13, 32'h2000_0004}
+                                 : cyc == 10 ? {4'd15, 32'hffff_ffff}
+                                 : cyc == 11 ? {4'd0, 32'h0000_0000}
+                                 : {4'd9, 32'hf000_0000})) begin
+            $write("%%Error: cyc=%0d addr=%x region=%0d attr=%x\n", cyc, addr, region, attr);
+            $stop;
+         end
+      end
+      if (cyc == 20) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
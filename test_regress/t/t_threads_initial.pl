@@ -0,0 +1,24 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2020 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+scenarios(vltmt => 1);
+
+compile(
+    verilator_flags2 => ['--cc --threads 2 --stats'],
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+# Initial logic spread over both threads; there is no combo logic to settle
+file_grep($Self->{stats}, qr/Order, initial\/settle threads\s+(\d+)/i, 2);
+
+ok(1);
+1;
@@ -0,0 +1,52 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2020 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer      cyc = 0;
+   integer      i;
+   integer      j;
+
+   // Independent tables, each may be filled on its own thread
+   reg [15:0]   squares [0:255];
+   reg [15:0]   cubes [0:255];
+   reg [7:0]    reversed [0:255];
+   reg [31:0]   sum;
+
+   initial begin
+      for (i = 0; i < 256; i = i + 1) squares[i] = i * i;
+   end
+   initial begin
+      for (j = 0; j < 256; j = j + 1) cubes[j] = j * j * j;
+   end
+   initial begin : rev
+      integer k;
+      for (k = 0; k < 256; k = k + 1) reversed[k] = 8'd255 - k[7:0];
+   end
+   // Shares sum with the check below; printing keeps it on the eval thread
+   initial begin
+      sum = 32'd0;
+      $write("[%0t] initial\n", $time);
+   end
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      sum <= sum + {16'h0, squares[cyc[7:0]]} + {16'h0, cubes[cyc[7:0]]}
+             + {24'h0, reversed[cyc[7:0]]};
+      if (cyc == 3) begin
+         if (squares[3] !== 16'd9) $stop;
+         if (cubes[3] !== 16'd27) $stop;
+         if (reversed[3] !== 8'd252) $stop;
+         // Cycles 0..2: 0+0+255, 1+1+254, 4+8+253
+         if (sum !== 32'd776) $stop;
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule